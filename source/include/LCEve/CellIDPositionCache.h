@@ -0,0 +1,68 @@
+#pragma once
+
+// -- std headers
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// -- root headers
+#include <ROOT/REveVector.hxx>
+
+namespace dd4hep {
+  class Detector ;
+  namespace rec {
+    class CellIDPositionConverter ;
+  }
+}
+
+namespace lceve {
+
+  /**
+   *  @brief  CellIDPositionCache class
+   *  Memoises the global position of detector cells from their cell id.
+   *  The positions are computed once through the DD4hep volume manager and
+   *  readout segmentation and kept across events and runs. Cell ids not
+   *  matching any volume are remembered as invalid.
+   *  Not thread safe: used by the converting thread only.
+   */
+  class CellIDPositionCache {
+  public:
+    using Position_t = ROOT::REveVectorT<float> ;
+
+  public:
+    CellIDPositionCache() = delete ;
+    CellIDPositionCache( const CellIDPositionCache & ) = delete ;
+    CellIDPositionCache &operator =( const CellIDPositionCache & ) = delete ;
+    ~CellIDPositionCache() ;
+
+    /// Constructor with the DD4hep detector
+    CellIDPositionCache( const dd4hep::Detector &detector ) ;
+
+    /// Get the global position (unit cm) of a cell. Returns std::nullopt for invalid cell ids
+    std::optional<Position_t> GetPosition( std::uint64_t cellID ) ;
+
+    /// Get the number of cached cells
+    std::size_t GetSize() const ;
+    /// Get the approximate memory used by the cache in bytes
+    std::size_t GetBytes() const ;
+    /// Get the number of lookups found in the cache
+    std::size_t GetHits() const ;
+    /// Get the number of lookups computed through DD4hep
+    std::size_t GetMisses() const ;
+    /// Forget all cached positions
+    void Clear() ;
+
+  private:
+    /// The DD4hep cell id to position converter
+    std::unique_ptr<dd4hep::rec::CellIDPositionConverter>   fConverter {nullptr} ;
+    /// The cached positions. Invalid cells have a NaN position
+    std::unordered_map<std::uint64_t, Position_t>           fPositions {} ;
+    /// The number of lookups found in the cache
+    std::size_t                                             fHits {0} ;
+    /// The number of lookups computed through DD4hep
+    std::size_t                                             fMisses {0} ;
+  };
+
+}
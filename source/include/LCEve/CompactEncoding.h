@@ -0,0 +1,67 @@
+#pragma once
+
+// -- std headers
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace lceve {
+
+  /**
+   *  @brief  CompactEncoding class
+   *  Optional compact encoding of the point positions of the event elements
+   *  (hits, clusters, track and particle lines) sent to the clients.
+   *  Positions are quantised on a grid of fixed resolution anchored at the
+   *  detector bounding box corner, delta-encoded from point to point, zigzag
+   *  mapped and written as variable length integers (7 bits per byte).
+   *  The decoder lives in the ui5 client (LCEveCompact.decode()).
+   *
+   *  Layout of the encoded buffer, in 32 bits words:
+   *  - word 0: magic number
+   *  - word 1: number of points
+   *  - word 2: resolution (float, cm)
+   *  - words 3-5: grid origin (float, cm)
+   *  - word 6: number of payload bytes
+   *  - words 7+: payload bytes, little endian, zero padded to a word
+   */
+  class CompactEncoding {
+  public:
+    /// The magic number of an encoded buffer ("LCE1")
+    static constexpr std::uint32_t fgMagic = 0x3145434c ;
+    /// The number of header words
+    static constexpr std::size_t fgHeaderWords = 7 ;
+
+  public:
+    CompactEncoding() = delete ;
+
+    /// Enable the encoding with a resolution (cm) and the grid origin (bounding box corner, cm)
+    static void Enable( float resolution, const std::array<float,3> &origin ) ;
+    /// Whether the encoding is enabled
+    static bool IsEnabled() ;
+    /// Get the resolution (cm)
+    static float GetResolution() ;
+
+    /// Encode n points (x, y, z consecutive) with the current settings
+    static void Encode( const float *points, std::size_t n, std::vector<std::uint32_t> &words ) ;
+    /// Encode n points (x, y, z consecutive) with a given resolution and origin
+    static void Encode( const float *points, std::size_t n, float resolution, const std::array<float,3> &origin, std::vector<std::uint32_t> &words ) ;
+    /// Decode an encoded buffer into points (x, y, z consecutive). Returns false if the buffer is invalid
+    static bool Decode( const std::vector<std::uint32_t> &words, std::vector<float> &points ) ;
+
+    /// Get the number of bytes of the encoded buffers since the last reset
+    static std::size_t GetEncodedBytes() ;
+    /// Get the number of bytes of the same points at full float precision since the last reset
+    static std::size_t GetRawBytes() ;
+    /// Reset the byte counters
+    static void ResetCounters() ;
+
+  private:
+    static bool                       fgEnabled ;
+    static float                      fgResolution ;
+    static std::array<float,3>        fgOrigin ;
+    static std::size_t                fgEncodedBytes ;
+    static std::size_t                fgRawBytes ;
+  };
+
+}
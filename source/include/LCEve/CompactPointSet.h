@@ -0,0 +1,26 @@
+#pragma once
+
+// -- root headers
+#include <ROOT/REvePointSet.hxx>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+namespace lceve {
+
+  /**
+   *  @brief  CompactPointSet class
+   *  A point set sending its positions with the compact encoding when it is
+   *  enabled (see CompactEncoding), decoded by the 'makeCompactHit' render
+   *  function of the client. Without ClassDef on purpose: the clients keep
+   *  seeing the type of the base class
+   */
+  class CompactPointSet : public ROOT::REvePointSet {
+  public:
+    using ROOT::REvePointSet::REvePointSet ;
+
+  private:
+    void BuildRenderData() override ;
+  };
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// -- root headers
+#include <ROOT/REveTrack.hxx>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+namespace lceve {
+
+  /**
+   *  @brief  CompactTrack class
+   *  A track sending its line points with the compact encoding when it is
+   *  enabled (see CompactEncoding), decoded by the 'makeCompactTrack' render
+   *  function of the client. Without ClassDef on purpose: the clients keep
+   *  seeing the type of the base class
+   */
+  class CompactTrack : public ROOT::REveTrack {
+  public:
+    using ROOT::REveTrack::REveTrack ;
+
+  private:
+    void BuildRenderData() override ;
+  };
+
+}
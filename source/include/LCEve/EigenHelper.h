@@ -0,0 +1,46 @@
+#pragma once
+
+// -- root headers
+#include <ROOT/REveVector.hxx>
+
+// -- std headers
+#include <array>
+#include <cstddef>
+
+namespace lceve {
+
+  /**
+   *  @brief  EigenHelper class
+   *  Eigen decomposition of 3x3 symmetric matrices (e.g covariance matrices)
+   *  with the cyclic Jacobi method. A matrix is given by its lower triangle
+   *  (xx, yx, yy, zx, zy, zz), as stored in LCIO.
+   */
+  class EigenHelper {
+  public:
+    /// A 3x3 symmetric matrix, lower triangle
+    using SymMatrix3_t = std::array<float,6> ;
+
+    /// The result of a decomposition
+    struct Eigen3 {
+      /// The eigen values
+      std::array<double,3>      fValues {} ;
+      /// The eigen vectors, as columns of a row major 3x3 matrix
+      std::array<double,9>      fVectors {} ;
+    };
+
+    /// The maximum number of Jacobi sweeps
+    static constexpr unsigned int fgMaxSweeps = 16 ;
+
+  public:
+    /// Decompose a single matrix
+    static Eigen3 Decompose( const SymMatrix3_t &matrix ) ;
+
+    /// Decompose n matrices at once
+    static void DecomposeBatch( const SymMatrix3_t *matrices, std::size_t n, Eigen3 *results ) ;
+
+    /// Get the half axes of the ellipsoid described by a decomposition:
+    /// the eigen vectors scaled by the square root of the eigen values and a scale factor
+    static std::array<ROOT::REveVectorT<float>,3> EllipsoidAxes( const Eigen3 &eigen, float scale ) ;
+  };
+
+}
@@ -7,6 +7,7 @@
 namespace lceve {
   
   class EventDisplay ;
+  class ObjectRegistry ;
 
   /// EveElementFactory class
   /// Helper class to convert objects (see LCEve/Objects.h)
@@ -15,6 +16,12 @@ namespace lceve {
   public:
     /// An additional factor to the vertex extents
     static constexpr float VertexExtentFactor = 500.f ;
+    /// The maximum distance (cm) between an analytic helix and its polyline
+    static constexpr double HelixSagittaTolerance = 0.02 ;
+    /// The maximum turning angle (rad) between two analytic helix points
+    static constexpr double HelixMaxStep = 0.2 ;
+    /// The minimum jet cone radius in (eta, phi), for jets with a single constituent
+    static constexpr float JetConeMinRadius = 0.05f ;
     
   public:
     EveElementFactory() = delete ;
@@ -27,20 +34,23 @@ namespace lceve {
      *  Factory methods for single object creation
      *  @{
      */
-    /// Create a track out track parameters
+    /// Create a track out track parameters.
+    /// If an element is registered for the user data, it is copied instead (see ObjectRegistry)
     EveTrack *CreateTrack( ROOT::REveTrackPropagator *propagator, const TrackParameters &parameters ) const ;
 
     /// Create a vertex out of vertex parameters
     EveVertex *CreateVertex( const VertexParameters &parameters ) const ;
     
-    /// Create a cluster out of cluster parameters
+    /// Create a cluster out of cluster parameters.
+    /// If an element is registered for the user data, it is copied instead (see ObjectRegistry)
     EveCluster *CreateCluster( const ClusterParameters &parameters ) const ;
 
     /// Create a reco particle out of reco particle parameters
     EveRecoParticle *CreateRecoParticle( const RecoParticleParameters &parameters ) const ;
 
-    /// Create a jet cone out of jet parameters
-    // EveJet *CreateJet( const JetParameters &parameters ) const ;
+    /// Create a jet cone out of jet parameters. The cone extends to the calorimeter face.
+    /// The constituents are added as children only if given in the parameters
+    EveJet *CreateJet( const JetParameters &parameters ) const ;
     
     /// Create a eve MC particle out of MC particle parameters
     EveMCParticle *CreateMCParticle( ROOT::REveTrackPropagator *propagator, const MCParticleParameters &parameters ) const ;
@@ -80,15 +90,40 @@ namespace lceve {
      *  @{
      */
     /// Populate the calo hit container with hits from parameters
-    void PopulateCaloHits( CaloHitContainer *container, const std::vector<CaloHitParameters> &caloHits ) const ;
+    void PopulateCaloHits( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits ) const ;
+    
+    /// Populate the calo hit container with the hits of highest amplitudes and return
+    /// the other hits in chunks of at most chunkSize hits, by decreasing amplitude.
+    /// The chunks have the name and marker attributes of the container
+    std::vector<std::unique_ptr<CaloHitContainer>> PopulateCaloHitChunks( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits, std::size_t chunkSize ) const ;
     
     /** @} */
     
   private:
+    /// Get the registry of the converted objects, nullptr if no event converter
+    ObjectRegistry *GetObjectRegistry() const ;
+    
+    /// Select the calo hits to display: the indices of the hits with the highest
+    /// amplitudes under memory pressure, nullopt if all hits are displayed
+    std::optional<std::vector<std::size_t>> SelectCaloHits( const ArenaVector<CaloHitParameters> &caloHits ) const ;
+    
+    /// Index the calo hits displayed as points of the container, in the same
+    /// order as they were populated
+    void IndexCaloHits( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits, const std::optional<std::vector<std::size_t>> &indices ) const ;
+    
     /// Convert the properties as string. Formatted to be displayed
     /// in an object tooltip
     std::string PropertiesAsString( const PropertyMap &properties ) const ;
     
+    /// Fill the track points from the analytic helix of the track parameters.
+    /// The point density adapts to the curvature and the line stops at the
+    /// propagator limits (max R, max Z, max orbits)
+    void MakeHelixTrack( EveTrack *eveTrack, ROOT::REveTrackPropagator *propagator, const TrackParameters &parameters ) const ;
+    
+    /// Fill the points of a neutral MC particle: a straight segment from the vertex
+    /// to the endpoint, or to the propagator limits if the endpoint is not set
+    void MakeStraightMCParticle( EveMCParticle *eveMCParticle, ROOT::REveTrackPropagator *propagator, const MCParticleParameters &parameters ) const ;
+    
   private:
     /// The event display manager object
     EventDisplay                  *fEventDisplay {nullptr} ;
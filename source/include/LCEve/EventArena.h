@@ -0,0 +1,98 @@
+#pragma once
+
+// -- std headers
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace lceve {
+
+  /// A vector allocated from the memory resource given at construction,
+  /// usually EventArena::GetResource(). Default constructed vectors use the heap
+  template <typename T>
+  using ArenaVector = std::pmr::vector<T> ;
+
+  /**
+   *  @brief  EventArena class
+   *  Monotonic memory resource for the short-lived objects created while
+   *  converting an event (object parameters, parameter lists). Memory is
+   *  bump-allocated in blocks and never freed individually. Reset() rewinds
+   *  the arena on event switch, keeping the blocks for the next event.
+   *  Not thread safe: an arena is used by a single converting thread.
+   */
+  class EventArena : public std::pmr::memory_resource {
+  public:
+    /// The default size of the first block
+    static constexpr std::size_t fgDefaultBlockSize = 1 << 20 ;
+
+    /**
+     *  @brief  Scope class
+     *  Marks the arena as in use from construction to destruction.
+     *  In the scope, GetResource() returns the arena
+     */
+    class Scope {
+    public:
+      Scope() = delete ;
+      Scope( const Scope & ) = delete ;
+      Scope &operator =( const Scope & ) = delete ;
+      /// Constructor with the arena
+      Scope( EventArena &arena ) ;
+      /// Destructor. Restores the previous arena state
+      ~Scope() ;
+
+    private:
+      EventArena                      &fArena ;
+      bool                             fPrevious {false} ;
+    };
+
+  public:
+    EventArena( const EventArena & ) = delete ;
+    EventArena &operator =( const EventArena & ) = delete ;
+    ~EventArena() = default ;
+
+    /// Constructor with the size of the first block
+    EventArena( std::size_t blockSize = fgDefaultBlockSize ) ;
+
+    /// Rewind the arena. All memory allocated so far is invalidated
+    void Reset() ;
+    /// Rewind the arena and give the blocks back to the system
+    void Release() ;
+
+    /// Get the number of bytes allocated since the last reset
+    std::size_t GetUsedBytes() const ;
+    /// Get the total size of the allocated blocks
+    std::size_t GetCapacity() const ;
+
+    /// Get the memory resource to construct the conversion containers with:
+    /// the arena within a Scope, the heap otherwise. The global default
+    /// memory resource is never changed
+    std::pmr::memory_resource *GetResource() ;
+
+  private:
+    void *do_allocate( std::size_t bytes, std::size_t alignment ) override ;
+    void do_deallocate( void *p, std::size_t bytes, std::size_t alignment ) override ;
+    bool do_is_equal( const std::pmr::memory_resource &other ) const noexcept override ;
+
+  private:
+    /// A memory block
+    struct Block {
+      std::unique_ptr<std::byte[]>     fData {nullptr} ;
+      std::size_t                      fSize {0} ;
+    };
+
+    /// The size of the first block
+    std::size_t                        fBlockSize {fgDefaultBlockSize} ;
+    /// The memory blocks
+    std::vector<Block>                 fBlocks {} ;
+    /// The current block index
+    std::size_t                        fCurrent {0} ;
+    /// The offset in the current block
+    std::size_t                        fOffset {0} ;
+    /// The number of bytes allocated since the last reset
+    std::size_t                        fUsedBytes {0} ;
+    /// Whether a Scope is active
+    bool                               fInScope {false} ;
+  };
+
+}
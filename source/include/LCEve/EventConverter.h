@@ -7,6 +7,9 @@
 
 // -- lceve headers
 #include <LCEve/ROOTTypes.h>
+#include <LCEve/EventArena.h>
+#include <LCEve/ObjectRegistry.h>
+#include <LCEve/RelationIndex.h>
 
 namespace EVENT {
   class LCEvent ;
@@ -20,30 +23,74 @@ namespace lceve {
   class ICollectionConverter ;
   
   /// EventConverter class
-  /// Converts a single LCIO event to eve element using collection converter plugins
+  /// Converts a single LCIO event to eve element using collection converter plugins.
+  /// Each collection has its own Eve scene. The collections are converted in priority
+  /// order and, with progressive streaming, each scene is sent to the clients as soon
+  /// as its collection is converted
   class EventConverter {
   public:
     using ConverterMap_t = std::map<std::string, std::shared_ptr<ICollectionConverter>> ;
+    using RelationIndexMap_t = std::map<std::string, RelationIndex> ;
+    using SceneMap_t = std::map<std::string, ROOT::REveScene*> ;
     
   public:
     /// Constructor
     EventConverter( EventDisplay *lced ) ;
     
-    /// Default destructor
-    ~EventConverter() = default ;
+    /// Destructor
+    ~EventConverter() ;
     
     /// Initialize the event converter.
-    /// Create and configure the collection converter plugins
+    /// Create and configure the collection converter plugins and their scenes
     void Init( const TiXmlElement *element ) ;
     
-    /// Load the event in the Eve event scene
-    void VisualizeEvent( const EVENT::LCEvent *const event, ROOT::REveScene *eventScene ) ;
+    /// Load the event in the collection scenes
+    void VisualizeEvent( const EVENT::LCEvent *const event ) ;
+    
+    /// Add an element to the scene of the collection being converted, or to a parent
+    /// element, and send it to the clients right away with progressive streaming.
+    /// Used to stream large collections in chunks
+    void StreamElement( ROOT::REveElement *element, ROOT::REveElement *parent = nullptr ) ;
+    
+    /// Enable or disable the progressive streaming (default on)
+    void SetProgressiveStreaming( bool progressive ) ;
+    
+    /// Get the collection scenes (collection name <-> scene)
+    const SceneMap_t &GetScenes() const ;
+    
+    /// Whether an element belongs to one of the collection scenes
+    bool IsEventElement( ROOT::REveElement *element ) const ;
+    
+    /// Get the registry of the objects converted for the current event
+    ObjectRegistry &GetObjectRegistry() ;
+    
+    /// Get the memory resource of the conversion temporaries:
+    /// the event arena while an event is converted, the heap otherwise
+    std::pmr::memory_resource *GetMemoryResource() ;
+    
+    /// Get the relation index of a collection of the current event, created if needed
+    RelationIndex &GetRelationIndex( const std::string &collectionName ) ;
+    
+    /// Get the relation indices of the current event (collection name <-> index)
+    const RelationIndexMap_t &GetRelationIndices() const ;
     
   private:
     /// Event display framework
     EventDisplay           *fEventDisplay {nullptr} ;
     /// The map of collection converters (collection name <-> converter)
     ConverterMap_t          fConverters {} ;
+    /// The arena of the conversion temporaries, reset on each event
+    EventArena              fArena {} ;
+    /// The objects converted for the current event
+    ObjectRegistry          fObjectRegistry {} ;
+    /// The relation indices of the current event
+    RelationIndexMap_t      fRelationIndices {} ;
+    /// The scene of each collection
+    SceneMap_t              fScenes {} ;
+    /// The scene of the collection being converted
+    ROOT::REveScene        *fCurrentScene {nullptr} ;
+    /// Whether the scenes are sent to the clients during the conversion
+    bool                    fProgressiveStreaming {true} ;
   };
   
 }
\ No newline at end of file
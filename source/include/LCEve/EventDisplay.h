@@ -7,11 +7,22 @@
 // -- lceve headers
 #include <LCEve/ROOTTypes.h>
 #include <LCEve/Settings.h>
+#include <LCEve/TimingReport.h>
+#include <LCEve/Metrics.h>
+#include <LCEve/MemoryMonitor.h>
+
+// -- std headers
+#include <memory>
+#include <vector>
+#include <LCEve/json.h>
 
 namespace EVENT {
   class LCEvent ;
 }
 
+class TNamed ;
+class TTimer ;
+
 namespace lceve {
 
   class EventNavigator ;
@@ -40,6 +51,22 @@ namespace lceve {
     void Run() ;
     /// [Slot] Quit the ROOT application
     void QuitRoot() ;
+    /// [Slot] Expand a geometry element by 'depth' levels
+    void ExpandGeometry( int elementId, int depth ) ;
+    /// [Slot] Collapse a geometry element, unloading its daughters
+    void CollapseGeometry( int elementId ) ;
+    /// [Slot] Build the constituents of a jet of the current event, if not yet built
+    void ExpandJet( int elementId ) ;
+    /// [Slot] Highlight all the elements showing the object of an element of the current
+    /// event and the objects it refers to (e.g the tracks, clusters and hits of a PFO)
+    void HighlightRelated( int elementId ) ;
+    /// [Slot] Highlight the objects linked to the object of an element of the current event
+    /// by the relation collections (e.g its MC particles), and print the links
+    void ShowTruth( int elementId ) ;
+    /// [Slot] Set the depth level of a subdetector
+    void SetSubdetectorLevel( const char *name, int level ) ;
+    /// [Slot] Print the startup timing report
+    void PrintStartupReport() ;
 
     /// Get the Eve manager instance
     ROOT::REveManager *GetEveManager() const ;
@@ -49,11 +76,27 @@ namespace lceve {
     TApplication *GetApplication() const ;
     /// Get the geometry handler
     Geometry *GetGeometry() const ;
+    /// Get the event converter
+    EventConverter *GetEventConverter() const ;
     /// Get the application settings
     const Settings &GetSettings() const ;
+    /// Get the startup timing report
+    TimingReport &GetStartupReport() ;
+    /// Get the pipeline metrics registry
+    Metrics &GetMetrics() ;
+    /// Get the memory monitor
+    MemoryMonitor &GetMemoryMonitor() ;
 
     /// Visualize the LCIO event
     void VisualizeEvent( const EVENT::LCEvent *const event ) ;
+    /// Destroy the elements of the previous event, detached from the event scene.
+    /// Called from the event loop once the new event is sent to the clients
+    void DestroyDetachedElements() ;
+
+  private:
+    int WriteCoreJson(nlohmann::json &j, int rnr_offset) override ;
+    /// Detach the elements from the collection scenes without destroying them
+    void DetachEventElements() ;
 
   private:
     TApplication                     *fApplication {nullptr} ;
@@ -62,6 +105,15 @@ namespace lceve {
     Geometry                         *fGeometry {nullptr} ;
     EventConverter                   *fEventConverter {nullptr} ;
     Settings                          fSettings {} ;
+    TimingReport                      fStartupReport {} ; //! transient
+    Metrics                           fMetrics {} ; //! transient
+    MemoryMonitor                     fMemoryMonitor {} ; //! transient
+    /// The web server page serving the metrics in text format
+    std::unique_ptr<TNamed>           fMetricsPage {nullptr} ; //! transient
+    /// The elements of the previous event, waiting for destruction
+    std::vector<ROOT::REveElement*>   fDetachedElements {} ; //! transient
+    /// The single shot timer destroying the detached elements
+    std::unique_ptr<TTimer>           fTeardownTimer {nullptr} ; //! transient
 
     ClassDef( EventDisplay, 0 ) ;
   };
@@ -45,6 +45,9 @@ namespace lceve {
     void Init() ;
     /// Open a new LCIO file
     void Open( const std::vector<std::string> &fnames ) ;
+    /// Open the LCIO files and build the run/event index.
+    /// Doesn't notify the clients, so it can run in a worker thread at startup
+    void Index( const std::vector<std::string> &fnames ) ;
     /// [Slot] Go to previous event
     void PreviousEvent() ;
     /// [Slot] Go to next event
@@ -2,6 +2,13 @@
 
 // -- std headers
 #include <string>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <memory>
+#include <array>
 
 // -- dd4hep headers
 #include <DD4hep/Detector.h>
@@ -12,15 +19,22 @@
 
 // -- root headers
 #include <ROOT/REveTrackPropagator.hxx>
+#include <TGeoMatrix.h>
 
 // -- lceve headers
 #include <LCEve/ROOTTypes.h>
 
 class TiXmlElement ;
+class TGeoVolume ;
+class TGeoShape ;
+class TGeoManager ;
 
 namespace lceve {
 
   class EventDisplay ;
+  class GeometryCache ;
+  class GeometryOptimizer ;
+  class CellIDPositionCache ;
 
   /**
    *  @brief  Geometry class
@@ -49,32 +63,95 @@ namespace lceve {
     ROOT::REveTrackPropagator *CreateTrackPropagator() const ;
     /// Create a new MC particle propagator
     ROOT::REveTrackPropagator *CreateMCParticlePropagator() const ;
+    /// Get the track propagator shared by all track collections, created on first call
+    ROOT::REveTrackPropagator *GetTrackPropagator() ;
+    /// Get the MC particle propagator shared by all MC particle collections, created on first call
+    ROOT::REveTrackPropagator *GetMCParticlePropagator() ;
     /// Get the global B field instance
     ROOT::REveMagField *GetBField() const ;
+    /// Get the calorimeter face radius (cm): the ECal barrel inner radius, where tracks stop
+    double GetCalorimeterFaceR() const ;
+    /// Get the calorimeter face half length (cm): the ECal endcap inner z, where tracks stop
+    double GetCalorimeterFaceZ() const ;
+    /// Get the detector bounding box (cm): x, y, z minima then maxima. Valid only after reading the geometry
+    std::array<float,6> GetBoundingBox() const ;
+    /// Get the cell id to position cache, created on first call. Kept across events and runs
+    CellIDPositionCache &GetCellIDPositionCache() ;
     /// Helper function to get the layered calorimeter data for a specific detector
     const dd4hep::rec::LayeredCalorimeterData *GetLayeredCaloData(unsigned int includeFlag, unsigned int excludeFlag = 0) const ;
 
+    /// Expand a geometry element by converting its daughters down to 'depth' levels below it.
+    /// Returns false if the element is not an expandable geometry element
+    bool ExpandElement( ROOT::REveElement *element, int depth ) ;
+    /// Collapse a geometry element: its daughters are unloaded.
+    /// Returns false if the element is not an expandable geometry element
+    bool CollapseElement( ROOT::REveElement *element ) ;
+    /// Set the depth level of a loaded subdetector. Returns false if the subdetector is not loaded
+    bool SetSubdetectorLevel( const std::string &name, int level ) ;
+    /// Get the loaded subdetectors with their current depth level, in loading order
+    const std::vector<std::pair<std::string, int>> &GetSubdetectorLevels() const ;
 
   private:
-    /// Recursive function creating an eve shape from a geo node
-    static ROOT::REveElement *CreateEveShape( int level, int maxLevel, ROOT::REveElement *parent,
+    /// A converted geometry element having daughters in the TGeo tree
+    struct GeometryNode {
+      /// The geo node the element was created from
+      TGeoNode                     *fNode {nullptr} ;
+      /// The global matrix of the geo node
+      TGeoHMatrix                   fMatrix {} ;
+      /// The depth level of the element (0 for subdetectors)
+      int                           fLevel {0} ;
+    };
+    using GeometryNodeMap = std::unordered_map<const ROOT::REveElement*, GeometryNode> ;
+    using SharedShapeMap = std::unordered_map<const TGeoVolume*, TGeoShape*> ;
+
+    /// Recursive function creating an eve shape from a geo node.
+    /// Can be called concurrently on different subdetectors
+    ROOT::REveElement *CreateEveShape( int level, int maxLevel, ROOT::REveElement *parent,
       TGeoNode *node, const TGeoHMatrix& mat, const std::string& name ) ;
 
-    /// Load the detector element (top level function)
-    static ROOT::REveElement *LoadDetElement( dd4hep::DetElement det, int levels, ROOT::REveElement* parent ) ;
+    /// Load the detector element (top level function).
+    /// Can be called concurrently on different subdetectors
+    ROOT::REveElement *LoadDetElement( dd4hep::DetElement det, int levels, ROOT::REveElement* parent ) ;
 
-    /// Load the DD4hep geometry in Eve 
-    void LoadGeometry( dd4hep::Detector &detector, const std::set<std::string> &subdets ) ;
+    /// Make a new scratch TGeoManager the global one, so that the cloned shapes
+    /// don't register in the DD4hep geo manager. The shared shapes are released
+    void CreateScratchGeoManager() ;
 
-    /// Extract the detector out of the compact file
-    /// Can be either the file name without extension
-    /// or from the <info> XML element in the compact file itself
-    std::string ExtractDetectorName( const std::string &compactFile ) const ;
+    /// Release the references held on the shared shapes and clear the map
+    void ReleaseSharedShapes() ;
+
+    /// Load the DD4hep geometry in Eve. Subdetectors found in the cache (if any)
+    /// are not converted, the others are converted and optimized concurrently in
+    /// detached elements, added to the cache and attached to the global scene in order
+    void LoadGeometry( dd4hep::Detector &detector, const std::set<std::string> &subdets, const GeometryOptimizer &optimizer, GeometryCache *cache ) ;
+
+    /// Recursively register the expandable elements of a converted element tree.
+    /// The daughter elements are matched to the geo node daughters by name
+    void RegisterElements( ROOT::REveElement *element, TGeoNode *node, const TGeoHMatrix& mat, int level ) ;
+
+    /// Recursively unregister an element tree before destroying it
+    void UnregisterElements( ROOT::REveElement *element ) ;
+
+    /// Recursively remove the elements not matching a geo node (merged shapes)
+    /// from a registered element tree
+    void RemoveMergedElements( ROOT::REveElement *element ) ;
+
+    /// Extract the detector name from the imported detector header
+    /// (<info> XML element in the compact file itself) or
+    /// from the compact file name without extension
+    std::string ExtractDetectorName( const dd4hep::Detector &detector, const std::string &compactFile ) const ;
     
     /// Cache geometry variables often accessed
     void CacheVariables() ;
 
   private:
+    /// Serializes the access to the global TGeo and TColor state while converting
+    static std::mutex                 fgTGeoMutex ;
+    /// The shapes cloned once per volume, shared by all the placements of the volume.
+    /// Guarded by fgTGeoMutex while converting
+    SharedShapeMap                    fSharedShapes {} ;
+    /// The scratch geo manager the shapes are cloned in (not owned, global ROOT state)
+    TGeoManager                      *fScratchGeoManager {nullptr} ;
     bool                              fLoaded {false} ;
     EventDisplay                     *fEventDisplay {nullptr} ;
     ROOT::REveMagField               *fBField {nullptr} ;
@@ -83,6 +160,18 @@ namespace lceve {
     double                            fTrackMaxZ {0.} ;
     double                            fMCParticleMaxR {0.} ;
     double                            fMCParticleMaxZ {0.} ;
+    /// The shared track propagator (reference held until destruction)
+    ROOT::REveTrackPropagator        *fTrackPropagator {nullptr} ;
+    /// The shared MC particle propagator (reference held until destruction)
+    ROOT::REveTrackPropagator        *fMCParticlePropagator {nullptr} ;
+    /// The expandable geometry elements
+    GeometryNodeMap                   fGeometryNodes {} ;
+    /// The loaded subdetectors with their top level element
+    std::map<std::string, ROOT::REveElement*> fSubdetectors {} ;
+    /// The loaded subdetectors with their current depth level
+    std::vector<std::pair<std::string, int>>  fSubdetectorLevels {} ;
+    /// The cell id to position cache
+    std::unique_ptr<CellIDPositionCache>      fCellIDPositionCache {nullptr} ;
   };
 
 }
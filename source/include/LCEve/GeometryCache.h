@@ -0,0 +1,101 @@
+#pragma once
+
+// -- std headers
+#include <string>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+class TObject ;
+class TFile ;
+class TGeoManager ;
+class TiXmlElement ;
+
+namespace ROOT {
+  namespace Experimental {
+    class REveGeoShapeExtract ;
+  }
+}
+
+namespace lceve {
+
+  /**
+   *  @brief  GeometryCache class
+   *  On-disk cache of the converted (tessellated) detector geometry.
+   *  The cache file is keyed by a hash of the compact XML tree (compact file
+   *  plus included files) and of the <geometry> section of the LCEve config.
+   *  Each subdetector is stored per detector level as a tree of shape extracts
+   *  holding the tessellated polygons. The cache file is memory-mapped
+   *  and read through a read-only TMemFile view, without copy.
+   */
+  class GeometryCache {
+  public:
+    GeometryCache() = delete ;
+    GeometryCache(const GeometryCache &) = delete ;
+    GeometryCache &operator =(const GeometryCache &) = delete ;
+    ~GeometryCache() ;
+
+    /// Constructor with cache directory, compact file and the LCEve <geometry> XML section (can be nullptr)
+    GeometryCache( const std::string &cacheDir, const std::string &compactFile, const TiXmlElement *geometry ) ;
+
+    /// Get the default cache directory: $LCEVE_GEOMETRY_CACHE or $HOME/.cache/lceve
+    static std::string DefaultDirectory() ;
+
+    /// Get the cache key (hexadecimal hash string)
+    const std::string &GetKey() const ;
+    /// Get the cache file path
+    std::string GetFilePath() const ;
+
+    /// Open the cache file if it exists. Returns false if there is no (valid) cache file
+    bool Open() ;
+    /// Release the mapped cache file
+    void Close() ;
+
+    /// Read a subdetector converted at the given level. Returns nullptr if not cached
+    ROOT::REveElement *ReadSubdetector( const std::string &name, int level ) const ;
+    /// Stage a converted subdetector for writing. The element is not modified
+    void AddSubdetector( const std::string &name, int level, ROOT::REveElement *element ) ;
+
+    /// Read the TGeoManager out of the cache. Returns nullptr if not cached
+    TGeoManager *ReadGeoManager() const ;
+    /// Stage the TGeoManager for writing
+    void AddGeoManager( TGeoManager *manager ) ;
+
+    /// Write all staged entries in the cache file
+    void Write() ;
+
+  private:
+    /// Get the key name of a subdetector entry in the cache file
+    static std::string EntryName( const std::string &name, int level ) ;
+    /// Recursively hash the compact file and the files it includes
+    static void HashCompactFile( const std::string &fname, std::uint64_t &hash, int depth ) ;
+    /// Hash a byte buffer (FNV-1a)
+    static void HashBytes( const char *data, std::size_t size, std::uint64_t &hash ) ;
+    /// Dump an Eve geometry element tree to a shape extract tree with tessellated shapes
+    static ROOT::REveGeoShapeExtract *DumpExtract( ROOT::REveElement *element ) ;
+    /// Re-create an Eve geometry element tree from a shape extract tree
+    static ROOT::REveElement *ImportExtract( ROOT::REveGeoShapeExtract *extract ) ;
+
+  private:
+    using StagedEntry_t = std::pair<std::string, std::unique_ptr<TObject>> ;
+    /// The cache directory
+    std::string                       fDirectory {} ;
+    /// The cache key
+    std::string                       fKey {} ;
+    /// The memory mapped cache file
+    void                             *fMapped {nullptr} ;
+    /// The size of the memory mapped cache file
+    std::size_t                       fMappedSize {0} ;
+    /// The in-memory ROOT file viewing the mapped region
+    std::unique_ptr<TFile>            fFile {nullptr} ;
+    /// Entries to write on next call to Write()
+    std::vector<StagedEntry_t>        fStaged {} ;
+    /// The geometry manager to write on next call to Write() (not owned)
+    TGeoManager                      *fStagedManager {nullptr} ;
+  };
+
+}
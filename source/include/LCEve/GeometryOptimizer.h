@@ -0,0 +1,66 @@
+#pragma once
+
+// -- std headers
+#include <mutex>
+#include <vector>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+namespace lceve {
+
+  class MergedPolyShape ;
+
+  /**
+   *  @brief  GeometryOptimizer class
+   *  Optimization pass on a converted subdetector element tree.
+   *  Sibling leaf shapes sharing the same shape (same volume) and visual
+   *  attributes are replaced by a single instanced shape. The remaining
+   *  sibling leaf shapes with identical visual attributes are merged into
+   *  single meshes. The merged meshes are then decimated (vertex clustering)
+   *  so that the subdetector does not exceed a triangle budget.
+   */
+  class GeometryOptimizer {
+  public:
+    GeometryOptimizer() = delete ;
+    GeometryOptimizer(const GeometryOptimizer &) = delete ;
+    GeometryOptimizer &operator =(const GeometryOptimizer &) = delete ;
+    ~GeometryOptimizer() = default ;
+
+    /// Constructor with instancing and merging flags and triangle budget per subdetector (0 means no decimation)
+    GeometryOptimizer( bool instanceShapes, bool mergeShapes, unsigned int triangleBudget ) ;
+
+    using ElementList_t = std::vector<ROOT::REveElement*> ;
+
+    /// Optimize a converted subdetector element tree, not yet attached to a scene.
+    /// The mutex serializes the shape tessellation which is not thread safe.
+    /// The replaced shapes are detached from the tree and appended to 'replaced',
+    /// protected from destruction: the caller destroys them on the main thread with
+    /// DestroyReplaced(), as destroying elements goes through the global Eve manager.
+    /// Can be called concurrently on different subdetectors
+    void Optimize( ROOT::REveElement *subdetector, std::mutex &tgeoMutex, ElementList_t &replaced ) const ;
+
+    /// Destroy the shapes replaced by Optimize(). Must be called on the main thread
+    static void DestroyReplaced( ElementList_t &replaced ) ;
+
+  private:
+    using MeshList_t = std::vector<MergedPolyShape*> ;
+
+    /// Detach a replaced shape from its parent without destroying it
+    static void DetachReplaced( ROOT::REveElement *parent, ROOT::REveElement *shape, ElementList_t &replaced ) ;
+
+    /// Recursively replace the sibling leaf shapes sharing the same shape by instanced shapes
+    void InstanceShapes( ROOT::REveElement *element, std::mutex &tgeoMutex, ElementList_t &replaced ) const ;
+    /// Recursively merge the sibling leaf shapes with identical visual attributes
+    void MergeShapes( ROOT::REveElement *element, MeshList_t &meshes, std::mutex &tgeoMutex, ElementList_t &replaced ) const ;
+
+  private:
+    /// Whether to instance sibling shapes placing the same volume
+    bool                              fInstanceShapes {true} ;
+    /// Whether to merge sibling shapes
+    bool                              fMergeShapes {true} ;
+    /// The maximum number of triangles of merged meshes per subdetector
+    unsigned int                      fTriangleBudget {0} ;
+  };
+
+}
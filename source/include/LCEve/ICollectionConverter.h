@@ -11,6 +11,7 @@
 
 // -- lcio headers
 #include <UTIL/BitField64.h>
+#include <EVENT/LCIO.h>
 
 namespace EVENT {
   class LCCollection ;
@@ -33,9 +34,22 @@ namespace lceve {
     /// Callback function to process a LCIO LCCollection
     virtual ROOT::REveElement* ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) = 0 ;
     
+    /// Callback function called once all the collections of the event are processed,
+    /// e.g to modify the elements of other collections. Does nothing by default
+    virtual void EndOfEvent() ;
+    
     /// Set the event display instance and input parameters
     void Initialize( EventDisplay *lceve, ParameterMap_t parameters ) ;
     
+    /// Whether the collection is flagged as lazy ('Lazy' parameter).
+    /// Lazy collections are skipped when the memory budget is exceeded
+    bool IsLazy() const ;
+    
+    /// The conversion priority of the collection ('Priority' parameter), lower first.
+    /// Defaults to an order by collection type: relations, particle flow objects,
+    /// vertices, tracks and clusters, MC particles, hits and finally simulated hits
+    int GetPriority( const std::string &typeName ) const ;
+    
   protected:
     /// Get the event display
     EventDisplay *GetEventDisplay() const ;
@@ -65,6 +79,41 @@ namespace lceve {
   
   //--------------------------------------------------------------------------
   
+  inline void ICollectionConverter::EndOfEvent() {
+    /* nop */
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  inline bool ICollectionConverter::IsLazy() const {
+    auto lazy = GetParameter<std::string>( "Lazy" ) ;
+    return lazy.has_value() and (lazy.value() == "true" or lazy.value() == "1") ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  inline int ICollectionConverter::GetPriority( const std::string &typeName ) const {
+    auto priority = GetParameter<int>( "Priority" ) ;
+    if( priority.has_value() ) {
+      return priority.value() ;
+    }
+    // relations are not drawn but indexed first
+    static const std::map<std::string, int> defaultPriorities = {
+      { EVENT::LCIO::LCRELATION, 0 },
+      { EVENT::LCIO::RECONSTRUCTEDPARTICLE, 1 },
+      { EVENT::LCIO::VERTEX, 2 },
+      { EVENT::LCIO::TRACK, 3 },
+      { EVENT::LCIO::CLUSTER, 3 },
+      { EVENT::LCIO::MCPARTICLE, 4 },
+      { EVENT::LCIO::SIMTRACKERHIT, 6 },
+      { EVENT::LCIO::SIMCALORIMETERHIT, 6 }
+    } ;
+    auto iter = defaultPriorities.find( typeName ) ;
+    return ( defaultPriorities.end() == iter ) ? 5 : iter->second ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
   inline EventDisplay *ICollectionConverter::GetEventDisplay() const {
     return fEventDisplay ;
   }
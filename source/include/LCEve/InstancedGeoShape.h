@@ -0,0 +1,82 @@
+#pragma once
+
+// -- root headers
+#include <ROOT/REveElement.hxx>
+#include <TClass.h>
+#include <Rtypes.h>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+#include <LCEve/json.h>
+
+// -- std headers
+#include <vector>
+
+class TGeoShape ;
+
+namespace ROOT {
+  namespace Experimental {
+    class REveGeoPolyShape ;
+    class REveTrans ;
+  }
+}
+
+namespace lceve {
+
+  /**
+   *  @brief  InstancedGeoShape class
+   *  A single geometry shape placed several times. The shape tessellation is
+   *  sent once to the clients together with the list of placement matrices
+   *  and drawn instanced. The shape is shared with the other users of the same
+   *  volume (reference counted through the shape unique id, as REveGeoShape does)
+   */
+  class InstancedGeoShape : public ROOT::REveElement {
+  public:
+    InstancedGeoShape( const InstancedGeoShape & ) = delete ;
+    InstancedGeoShape &operator =( const InstancedGeoShape & ) = delete ;
+
+    /// Constructor with name and title
+    InstancedGeoShape( const std::string &name = "InstancedGeoShape", const std::string &title = "" ) ;
+    /// Destructor
+    ~InstancedGeoShape() ;
+
+    /// Set the shape (shared, not cloned)
+    void SetShape( TGeoShape *shape ) ;
+    /// Get the shape
+    TGeoShape *GetShape() const ;
+    /// Set the number of segments used for the tessellation
+    void SetNSegments( int nSegments ) ;
+    /// Get the number of segments used for the tessellation
+    int GetNSegments() const ;
+
+    /// Add a placement of the shape
+    void AddInstance( const ROOT::REveTrans &trans ) ;
+    /// Get the number of placements
+    std::size_t GetNInstances() const ;
+    /// Get the placement matrices (4x4 column major, 16 values per placement)
+    const std::vector<Double_t> &RefPlacements() const ;
+
+    /// Create a tessellated copy of the shape. The caller owns the returned shape
+    ROOT::REveGeoPolyShape *MakePolyShape() const ;
+
+    /// The shape extract title identifying instanced shapes in geometry cache files
+    static const char *ExtractTitle() ;
+
+  private:
+    int WriteCoreJson( nlohmann::json &j, int rnr_offset ) override ;
+    void BuildRenderData() override ;
+
+  private:
+    /// The element color
+    Color_t                    fColor {0} ;
+    /// The shared shape
+    TGeoShape                 *fShape {nullptr} ;
+    /// The number of segments for tessellation
+    int                        fNSegments {60} ;
+    /// The placement matrices
+    std::vector<Double_t>      fPlacements {} ;
+
+    ClassDef( InstancedGeoShape, 0 ) ;
+  };
+
+}
@@ -3,6 +3,7 @@
 // -- std headers
 #include <type_traits>
 #include <vector>
+#include <cstdint>
 
 // -- lcio headers
 #include <EVENT/LCCollection.h>
@@ -50,6 +51,13 @@ namespace lceve {
       return ROOT::REveVector( helix.getMomentum() ) ;  
     }
     
+    /// Get the 64 bits cell id of a hit
+    template <typename T>
+    static std::uint64_t GetCellID( const T *hit ) {
+      return (static_cast<std::uint64_t>( static_cast<std::uint32_t>( hit->getCellID0() ) ) |
+        (static_cast<std::uint64_t>( static_cast<std::uint32_t>( hit->getCellID1() ) ) << 32)) ;
+    }
+    
     template <typename T>
     static float GetEnergy( const T *hit ) {
       return hit->getEnergy() ;
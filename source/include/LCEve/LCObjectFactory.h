@@ -41,9 +41,10 @@ namespace lceve {
     VertexParameters ConvertVertex( const EVENT::Vertex *const vertex ) const ;
     
     /// Convert LCIO hit objects
-    /// Works with CalorimeterHit and SimCalorimeterHit
+    /// Works with CalorimeterHit, SimCalorimeterHit and RawCalorimeterHit.
+    /// Raw hit positions are decoded from the cell id (see CellIDPositionCache)
     template <typename T>
-    std::vector<CaloHitParameters> ConvertCaloHits( const std::vector<T*> &caloHits ) const ;
+    ArenaVector<CaloHitParameters> ConvertCaloHits( const std::vector<T*> &caloHits ) const ;
     
     // /// Convert a LCIO sim calo hit object
     // CaloHitParameters ConvertCaloHit( const EVENT::SimCalorimeterHit *const caloHit ) const ;
@@ -54,16 +55,27 @@ namespace lceve {
     /// Convert a LCIO reco particle object
     RecoParticleParameters ConvertRecoParticle( const EVENT::ReconstructedParticle *const recoParticle ) const ;
     
-    // /// Convert a LCIO jet (reco particle) object
-    // JetParameters ConvertJet( const EVENT::ReconstructedParticle *const jet ) const ;
+    /// Convert a LCIO jet (reco particle) object.
+    /// The cone radius is the largest distance in (eta, phi) of the constituents to the jet axis.
+    /// The constituents are converted only if requested
+    JetParameters ConvertJet( const EVENT::ReconstructedParticle *const jet, bool withConstituents = false ) const ;
     
     /// Convert a LCIO MC particle object
     MCParticleParameters ConvertMCParticle( const EVENT::MCParticle *const mcp ) const ;
     
     // TODO Tracker Hit, etc ...
     
+    /// Get the memory resource to construct the parameter lists with:
+    /// the event arena while an event is converted, the heap otherwise
+    std::pmr::memory_resource *GetMemoryResource() const ;
+    
   private:     
     EventDisplay          *fEventDisplay {nullptr} ;
   };
+  
+  //--------------------------------------------------------------------------
+  
+  template <>
+  ArenaVector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::RawCalorimeterHit*> &caloHits ) const ;
     
 }
\ No newline at end of file
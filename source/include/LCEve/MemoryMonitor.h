@@ -0,0 +1,112 @@
+#pragma once
+
+// -- std headers
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <cstddef>
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+namespace EVENT {
+  class LCEvent ;
+}
+
+namespace lceve {
+
+  class Metrics ;
+
+  /**
+   *  @brief  MemoryMonitor class
+   *  Accounts the memory held by the decoded LCIO event, the converted Eve
+   *  elements and the registered caches, and checks the process resident
+   *  memory against a global budget. Past the budget, the display degrades
+   *  in steps: caches are dropped, then large point sets are reduced (level
+   *  of detail), then the collections flagged as lazy are skipped.
+   *  The event and element sizes are estimates.
+   */
+  class MemoryMonitor {
+  public:
+    /// The degradation levels, in increasing order
+    enum class Degradation {
+      None = 0,
+      DropCaches,
+      LevelOfDetail,
+      SkipLazy
+    };
+    using SizeFunction = std::function<std::size_t()> ;
+    using DropFunction = std::function<void()> ;
+
+    /// The maximum number of points per point set in level of detail mode
+    static constexpr std::size_t fgLODMaxPoints = 10000 ;
+
+  public:
+    MemoryMonitor() = default ;
+    MemoryMonitor( const MemoryMonitor & ) = delete ;
+    MemoryMonitor &operator =( const MemoryMonitor & ) = delete ;
+
+    /// Set the memory budget in bytes (0 means no budget)
+    void SetBudget( std::size_t bytes ) ;
+    /// Get the memory budget in bytes
+    std::size_t GetBudget() const ;
+
+    /// Register a cache with a function returning its size and a function dropping its content
+    void RegisterCache( const std::string &name, SizeFunction size, DropFunction drop ) ;
+    /// Unregister a cache
+    void UnregisterCache( const std::string &name ) ;
+    /// Get the total size of the registered caches
+    std::size_t GetCacheBytes() const ;
+    /// Drop the content of all registered caches
+    void DropCaches() ;
+
+    /// Set the estimated size of the decoded event
+    void SetEventBytes( std::size_t bytes ) ;
+    /// Set the estimated size of the converted elements
+    void SetElementBytes( std::size_t bytes ) ;
+
+    /// Check the resident memory against the budget and update the degradation level.
+    /// Drops the caches if the budget is exceeded
+    Degradation Update() ;
+    /// Get the current degradation level
+    Degradation GetDegradation() const ;
+
+    /// Print the memory accounting and record it in the metrics
+    void Report( Metrics &metrics ) const ;
+
+    /// Get the resident memory of the process in bytes
+    static std::size_t GetResidentBytes() ;
+    /// Get the peak resident memory of the process in bytes
+    static std::size_t GetPeakResidentBytes() ;
+    /// Estimate the size of a decoded LCIO event in bytes
+    static std::size_t EstimateEventBytes( const EVENT::LCEvent *const event ) ;
+    /// Estimate the size of an Eve element tree in bytes
+    static std::size_t EstimateElementBytes( ROOT::REveElement *element ) ;
+    /// Parse a memory size with an optional K, M or G suffix (e.g 8G)
+    static std::size_t ParseSize( const std::string &size ) ;
+
+  private:
+    /// A registered cache
+    struct Cache {
+      std::string           fName {} ;
+      SizeFunction          fSize {} ;
+      DropFunction          fDrop {} ;
+    };
+
+  private:
+    /// Protects the cache list
+    mutable std::mutex                fMutex {} ;
+    /// The memory budget in bytes
+    std::size_t                       fBudget {0} ;
+    /// The registered caches
+    std::vector<Cache>                fCaches {} ;
+    /// The estimated size of the decoded event
+    std::size_t                       fEventBytes {0} ;
+    /// The estimated size of the converted elements
+    std::size_t                       fElementBytes {0} ;
+    /// The current degradation level
+    Degradation                       fDegradation {Degradation::None} ;
+  };
+
+}
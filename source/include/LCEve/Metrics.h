@@ -0,0 +1,94 @@
+#pragma once
+
+// -- std headers
+#include <string>
+#include <map>
+#include <array>
+#include <mutex>
+#include <chrono>
+
+// -- lceve headers
+#include <LCEve/json.h>
+
+namespace lceve {
+
+  /**
+   *  @brief  Metrics class
+   *  Registry of named pipeline metrics: counters, gauges and histograms.
+   *  Metric names may carry labels, e.g. 'lceve_convert_seconds{collection="Tracks"}'.
+   *  The registry can be dumped in the Prometheus text format and summarised
+   *  in json. All methods are thread safe.
+   */
+  class Metrics {
+  public:
+    /// The histogram bucket upper bounds. Covers seconds, counts and bytes
+    static constexpr std::array<double, 14> fgBucketBounds = {
+      1e-4, 1e-3, 1e-2, 0.1, 1., 10., 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+    } ;
+
+    /// A histogram of observed values
+    struct Histogram {
+      /// The number of observations per bucket (last one is +Inf)
+      std::array<unsigned long, fgBucketBounds.size()+1> fBuckets {} ;
+      /// The number of observations
+      unsigned long          fCount {0} ;
+      /// The sum of observations
+      double                 fSum {0.} ;
+      /// The maximum observed value
+      double                 fMax {0.} ;
+      /// The last observed value
+      double                 fLast {0.} ;
+    };
+
+    /**
+     *  @brief  Timer class
+     *  Observes the time elapsed (in seconds) from construction to destruction
+     */
+    class Timer {
+    public:
+      Timer() = delete ;
+      Timer( const Timer & ) = delete ;
+      Timer &operator =( const Timer & ) = delete ;
+      /// Constructor with the metrics registry and the histogram name
+      Timer( Metrics &metrics, const std::string &name ) ;
+      /// Destructor. Observes the elapsed time
+      ~Timer() ;
+
+    private:
+      Metrics                                 &fMetrics ;
+      std::string                              fName {} ;
+      std::chrono::steady_clock::time_point    fStart {} ;
+    };
+
+  public:
+    Metrics() = default ;
+    Metrics( const Metrics & ) = delete ;
+    Metrics &operator =( const Metrics & ) = delete ;
+
+    /// Build a metric name with a single label
+    static std::string Name( const std::string &name, const std::string &label, const std::string &value ) ;
+
+    /// Increment a counter
+    void Increment( const std::string &name, double value = 1. ) ;
+    /// Set a gauge value
+    void Set( const std::string &name, double value ) ;
+    /// Observe a value in a histogram
+    void Observe( const std::string &name, double value ) ;
+
+    /// Dump all metrics in the Prometheus text format
+    std::string ToText() const ;
+    /// Summarise all metrics in json (last/mean/max values for histograms)
+    nlohmann::json Summary() const ;
+
+  private:
+    /// Protects the metric maps
+    mutable std::mutex                     fMutex {} ;
+    /// The counters
+    std::map<std::string, double>          fCounters {} ;
+    /// The gauges
+    std::map<std::string, double>          fGauges {} ;
+    /// The histograms
+    std::map<std::string, Histogram>       fHistograms {} ;
+  };
+
+}
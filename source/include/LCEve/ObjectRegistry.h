@@ -0,0 +1,155 @@
+#pragma once
+
+// -- lceve headers
+#include <LCEve/ROOTTypes.h>
+
+// -- root headers
+#include <ROOT/REveElement.hxx>
+
+// -- std headers
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+
+namespace lceve {
+
+  /**
+   *  @brief  ObjectRegistry class
+   *  Per-event map from framework objects (e.g LCIO objects, see the
+   *  fUserData of the object parameters) to the first Eve element created
+   *  for them. An object appearing in several collections (a track in the
+   *  track collection and in its PFO) is converted once and the other
+   *  elements are copied from the registered one.
+   *  The registry also indexes all the elements showing an object, including
+   *  the points of point sets (e.g calorimeter hits), so that the elements
+   *  related to a selected object are found without walking the scene.
+   *  Elements are registered only within a Scope, while converting an event.
+   *  The entries remain valid as long as the event is displayed.
+   */
+  class ObjectRegistry {
+  public:
+    /**
+     *  @brief  Scope class
+     *  Clears the registry and enables the registration of new elements
+     *  from construction to destruction. Elements added to the displayed
+     *  event later on (e.g expanded jets) are registered in a scope that
+     *  doesn't clear the registry
+     */
+    class Scope {
+    public:
+      Scope() = delete ;
+      Scope( const Scope & ) = delete ;
+      Scope &operator =( const Scope & ) = delete ;
+      /// Constructor with the registry and whether to clear it
+      Scope( ObjectRegistry &registry, bool clear = true ) ;
+      /// Destructor. Restores the previous registration state
+      ~Scope() ;
+
+    private:
+      ObjectRegistry                 &fRegistry ;
+      bool                            fPrevious {false} ;
+    };
+
+    /// An element showing an object
+    struct Entry {
+      /// The element
+      ROOT::REveElement                *fElement {nullptr} ;
+      /// The index of the object in the element (point index, line index), -1 for the whole element
+      int                               fIndex {-1} ;
+    };
+
+  public:
+    ObjectRegistry() = default ;
+    ObjectRegistry( const ObjectRegistry & ) = delete ;
+    ObjectRegistry &operator =( const ObjectRegistry & ) = delete ;
+    ~ObjectRegistry() = default ;
+
+    /// Register the element created for an object. Ignored outside of a scope
+    /// or if an element is already registered for this object
+    void Register( const void *object, ROOT::REveElement *element ) ;
+    /// Find the element registered for an object. Returns nullptr if not found
+    /// or if the element is not of type T
+    template <typename T>
+    T *Find( const void *object ) const ;
+    /// Count an element copied from a registered one
+    void CountReused() ;
+    /// Add an element, or one of its points (index >= 0), showing an object to the index.
+    /// Registered elements are indexed automatically. Ignored outside of a scope
+    void Index( const void *object, ROOT::REveElement *element, int index = -1 ) ;
+    /// Index the n first points of an element, the point i showing objects[i] (nullptr to skip).
+    /// One call per point set instead of one Index() per point: the entries are appended
+    /// to a flat array, sorted on the next lookup. Ignored outside of a scope
+    void IndexRange( ROOT::REveElement *element, const void *const *objects, std::size_t n ) ;
+    /// Index the points of a copy of an indexed element, as for the original
+    void IndexCopy( const ROOT::REveElement *original, ROOT::REveElement *copy ) ;
+    /// Call function( const Entry & ) for each element showing an object
+    template <typename F>
+    void ForEachEntry( const void *object, F function ) const ;
+
+    /// Get the number of registered objects
+    std::size_t GetSize() const ;
+    /// Get the number of elements copied from registered ones since the last clear
+    std::size_t GetReused() const ;
+    /// Get the number of index entries
+    std::size_t GetIndexSize() const ;
+    /// Remove all entries
+    void Clear() ;
+
+  private:
+    /// An index entry of the flat array
+    using RangeEntry = std::pair<const void*, Entry> ;
+
+    /// Sort the flat index entries by object, if needed
+    void SortRanges() const ;
+
+  private:
+    /// The registered elements
+    std::unordered_map<const void*, ROOT::REveElement*>   fElements {} ;
+    /// All the elements showing an object
+    std::unordered_multimap<const void*, Entry>           fIndex {} ;
+    /// The objects shown by the points of the indexed elements
+    std::unordered_map<const ROOT::REveElement*, std::vector<const void*>>   fPoints {} ;
+    /// The points indexed by range, sorted by object on lookup
+    mutable std::vector<RangeEntry>                       fRangeEntries {} ;
+    /// Whether the range entries are sorted
+    mutable bool                                          fRangesSorted {true} ;
+    /// Whether new elements can be registered
+    bool                                                  fEnabled {false} ;
+    /// The number of elements copied from registered ones
+    std::size_t                                           fReused {0} ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  template <typename T>
+  inline T *ObjectRegistry::Find( const void *object ) const {
+    auto iter = fElements.find( object ) ;
+    if( fElements.end() == iter ) {
+      return nullptr ;
+    }
+    return dynamic_cast<T*>( iter->second ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename F>
+  inline void ObjectRegistry::ForEachEntry( const void *object, F function ) const {
+    auto range = fIndex.equal_range( object ) ;
+    for( auto iter = range.first ; iter != range.second ; ++iter ) {
+      function( iter->second ) ;
+    }
+    if( fRangeEntries.empty() ) {
+      return ;
+    }
+    this->SortRanges() ;
+    auto iter = std::lower_bound( fRangeEntries.begin(), fRangeEntries.end(), object, []( const RangeEntry &entry, const void *obj ) {
+      return std::less<const void*>()( entry.first, obj ) ;
+    }) ;
+    for( ; (fRangeEntries.end() != iter) and (iter->first == object) ; ++iter ) {
+      function( iter->second ) ;
+    }
+  }
+
+}
@@ -3,6 +3,9 @@
 // -- lceve headers
 #include <LCEve/ROOTTypes.h>
 #include <LCEve/json.h>
+#include <LCEve/EventArena.h>
+#include <LCEve/CompactPointSet.h>
+#include <LCEve/CompactTrack.h>
 
 // -- root headers
 #include <ROOT/REveVector.hxx>
@@ -28,16 +31,16 @@ namespace lceve {
   using RecoParticleContainer = ROOT::REveElement ;
   using JetContainer = ROOT::REveElement ;
   using MCParticleContainer = ROOT::REveElement ;
-  using CaloHitContainer = ROOT::REvePointSet ;
-  using TrackerHitContainer = ROOT::REvePointSet ;
+  using CaloHitContainer = CompactPointSet ;
+  using TrackerHitContainer = CompactPointSet ;
 
   /// Eve element containers for each object type
-  using EveTrack = ROOT::REveTrack ;
+  using EveTrack = CompactTrack ;
   using EveVertex = ROOT::REveEllipsoid ;
   using EveCluster = CaloHitContainer ;
   using EveRecoParticle = ROOT::REveCompound ;
   using EveJet = ROOT::REveJetCone ;
-  using EveMCParticle = ROOT::REveTrack ;
+  using EveMCParticle = CompactTrack ;
   // NOTE: Calo hit and tracker hit have no Eve equivalents
   // They are stored internally in their parent container
   
@@ -87,6 +90,15 @@ namespace lceve {
   };
 
 
+  /// TrackRenderMode enum
+  enum class TrackRenderMode {
+    /// Numerical stepping with the track propagator
+    Propagator = 1,
+    /// Analytic helix, assuming a uniform field along the track
+    Helix = 2
+  };
+
+
   /// TrackInfo struct
   struct TrackInfo {
     /// The track reference point
@@ -112,8 +124,10 @@ namespace lceve {
     std::optional<MarkerAttributes>                    fMarkerAttributes {} ;
     /// The track charge
     std::optional<int>                                 fCharge {} ;
+    /// How to compute the track line (default is Propagator)
+    std::optional<TrackRenderMode>                     fRenderMode {} ;
     /// An optional list of track markers (AKA track state)
-    std::vector<TrackState>                            fTrackStates {} ;
+    std::optional<ArenaVector<TrackState>>             fTrackStates {} ;
     /// Whether the track is pickable on the display (default is true)
     std::optional<bool>                                fPickable {true} ;
     /// Optional user data (framework track ?)
@@ -130,6 +144,8 @@ namespace lceve {
     std::optional<unsigned int>                        fLevel {} ;
     /// The vertex fit error: the lower triangle of the covariance matrix of the position
     std::optional<std::array<float,6>>                 fErrors {} ;
+    /// The half axes of the vertex ellipsoid. Computed from the errors if not set
+    std::optional<std::array<ROOT::REveVectorT<float>,3>> fAxes {} ;
     /// The reconstructed vertex position
     std::optional<ROOT::REveVectorT<float>>            fPosition {} ;
     /// The vertex line attributes
@@ -153,6 +169,8 @@ namespace lceve {
     std::optional<std::array<float,24>>                fBoxCorners {} ;
     /// The calo hit transparency
     std::optional<Char_t>                              fTransparency {0} ;
+    /// Optional user data (framework calo hit ?)
+    std::optional<void*>                               fUserData {} ;
   };
 
 
@@ -164,7 +182,9 @@ namespace lceve {
     /// The cluster marker attributes
     std::optional<MarkerAttributes>                    fMarkerAttributes {} ;
     /// The list of calorimeter hits
-    std::optional<std::vector<CaloHitParameters>>      fCaloHits {} ;
+    std::optional<ArenaVector<CaloHitParameters>>      fCaloHits {} ;
+    /// Optional user data (framework cluster ?)
+    std::optional<void*>                               fUserData {} ;
     /// Additional cluster properties
     PropertyMap                                        fProperties {} ;
   };
@@ -180,12 +200,14 @@ namespace lceve {
     /// The reco particle mass. If not given, computed from energy and momentum
     std::optional<float>                               fMass {} ;
     /// The list of tracks
-    std::optional<std::vector<TrackParameters>>        fTracks {} ;
+    std::optional<ArenaVector<TrackParameters>>        fTracks {} ;
     /// The list of cluster
-    std::optional<std::vector<ClusterParameters>>      fClusters {} ;
+    std::optional<ArenaVector<ClusterParameters>>      fClusters {} ;
     /// If this color attibute is set, it will replace
     /// the color of all tracks and clusters
     std::optional<Color_t>                             fColor {} ;    
+    /// Optional user data (framework particle ?)
+    std::optional<void*>                               fUserData {} ;
     /// Additional particle properties
     PropertyMap                                        fProperties {} ;
   };
@@ -202,8 +224,16 @@ namespace lceve {
     std::optional<ROOT::REveVectorT<float>>            fMomentum {} ;
     /// The jet mass. If not given, computed from energy and momentum
     std::optional<float>                               fMass {} ;
+    /// The number of constituents, whether they are built or not
+    std::optional<unsigned int>                        fNConstituents {} ;
+    /// The jet cone color
+    std::optional<Color_t>                             fColor {} ;
     /// An optional list of reco particle to build
-    std::optional<std::vector<RecoParticleParameters>> fParticles {} ;
+    std::optional<ArenaVector<RecoParticleParameters>> fParticles {} ;
+    /// Optional user data (framework jet ?)
+    std::optional<void*>                               fUserData {} ;
+    /// Additional jet properties
+    PropertyMap                                        fProperties {} ;
   };
   
   /// MCParticleParameters struct 
@@ -0,0 +1,131 @@
+#pragma once
+
+// -- std headers
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace EVENT {
+  class LCObject ;
+  class LCCollection ;
+}
+
+namespace lceve {
+
+  /**
+   *  @brief  RelationIndex class
+   *  Bidirectional index of a LCRelation collection (e.g RecoMCTruthLink),
+   *  built once per event. The links of each object are stored contiguously
+   *  (compressed rows), sorted by decreasing weight, so that a query costs
+   *  a single hash lookup instead of a scan of the collection as with
+   *  UTIL::LCRelationNavigator. The weights are kept as stored in the
+   *  collection. The memory is kept from one event to the next.
+   */
+  class RelationIndex {
+  public:
+    /// A link to a related object
+    struct Link {
+      /// The related object
+      const EVENT::LCObject          *fObject {nullptr} ;
+      /// The relation weight
+      float                           fWeight {0.f} ;
+    };
+
+  public:
+    RelationIndex() = default ;
+    ~RelationIndex() = default ;
+
+    /// Build the index from a LCRelation collection, replacing the current content
+    void Build( const EVENT::LCCollection *const collection ) ;
+    /// Call function( const Link & ) for each object related to a 'from' object, highest weight first
+    template <typename F>
+    void ForEachTo( const EVENT::LCObject *from, F function ) const ;
+    /// Call function( const Link & ) for each object related to a 'to' object, highest weight first
+    template <typename F>
+    void ForEachFrom( const EVENT::LCObject *to, F function ) const ;
+    /// Get the 'to' object with the highest weight for a 'from' object, nullptr if none
+    const Link *GetBestTo( const EVENT::LCObject *from ) const ;
+    /// Get the 'from' object with the highest weight for a 'to' object, nullptr if none
+    const Link *GetBestFrom( const EVENT::LCObject *to ) const ;
+    /// Call function( const EVENT::LCObject * ) for each object with at least one 'to' link, in collection order
+    template <typename F>
+    void ForEachFromObject( F function ) const ;
+    /// Call function( const EVENT::LCObject * ) for each object with at least one 'from' link, in collection order
+    template <typename F>
+    void ForEachToObject( F function ) const ;
+
+    /// Get the number of relations
+    std::size_t GetSize() const ;
+    /// Remove all relations, keeping the allocated memory
+    void Clear() ;
+
+  private:
+    /// One direction of the index
+    struct Table {
+      /// Fill the table from (key, link) pairs
+      void Build( const std::vector<std::pair<const EVENT::LCObject*, Link>> &links ) ;
+      /// Get the links of an object as [begin, end) pointers
+      std::pair<const Link*, const Link*> Find( const EVENT::LCObject *object ) const ;
+      /// Remove all entries
+      void Clear() ;
+
+      /// The row of each object
+      std::unordered_map<const EVENT::LCObject*, std::uint32_t>  fRows {} ;
+      /// The objects in row order
+      std::vector<const EVENT::LCObject*>                         fObjects {} ;
+      /// The first link of each row, plus the end of the last row
+      std::vector<std::uint32_t>                                  fOffsets {} ;
+      /// The links, sorted by row then by decreasing weight
+      std::vector<Link>                                           fLinks {} ;
+    };
+
+  private:
+    /// The 'from' to 'to' links
+    Table                         fFromTable {} ;
+    /// The 'to' to 'from' links
+    Table                         fToTable {} ;
+    /// Build buffer, kept to reuse its memory
+    std::vector<std::pair<const EVENT::LCObject*, Link>>   fBuffer {} ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  template <typename F>
+  inline void RelationIndex::ForEachTo( const EVENT::LCObject *from, F function ) const {
+    auto range = fFromTable.Find( from ) ;
+    for( auto link = range.first ; link != range.second ; ++link ) {
+      function( *link ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename F>
+  inline void RelationIndex::ForEachFrom( const EVENT::LCObject *to, F function ) const {
+    auto range = fToTable.Find( to ) ;
+    for( auto link = range.first ; link != range.second ; ++link ) {
+      function( *link ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename F>
+  inline void RelationIndex::ForEachFromObject( F function ) const {
+    for( auto object : fFromTable.fObjects ) {
+      function( object ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename F>
+  inline void RelationIndex::ForEachToObject( F function ) const {
+    for( auto object : fToTable.fObjects ) {
+      function( object ) ;
+    }
+  }
+
+}
@@ -3,6 +3,7 @@
 // -- std headers
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace lceve {
 
@@ -30,9 +31,24 @@ namespace lceve {
     inline void SetDSTMode( bool dst ) { fDstMode = dst ; }
     inline bool GetDSTMode() const { return fDstMode ; }
 
+    /// The directory of the converted geometry cache. Empty means no cache
+    inline void SetGeometryCacheDirectory( const std::string &dir ) { fGeometryCacheDirectory = dir ; }
+    inline const std::string &GetGeometryCacheDirectory() const     { return fGeometryCacheDirectory ; }
+
+    /// The process memory budget in bytes. 0 means no budget
+    inline void SetMemoryBudget( std::size_t bytes ) { fMemoryBudget = bytes ; }
+    inline std::size_t GetMemoryBudget() const       { return fMemoryBudget ; }
+
+    /// The resolution (cm) of the compact encoding of the event positions. 0 means full precision
+    inline void SetCompactEncodingResolution( float resolution ) { fCompactEncodingResolution = resolution ; }
+    inline float GetCompactEncodingResolution() const            { return fCompactEncodingResolution ; }
+
   private:
     std::vector<std::string>           fReadCollectionNames {} ;
     int                                fDetectorLevel {1} ;
+    std::string                        fGeometryCacheDirectory {} ;
+    std::size_t                        fMemoryBudget {0} ;
+    float                              fCompactEncodingResolution {0.f} ;
     bool                               fServerMode {false} ;
     bool                               fDstMode {false} ;
   };
@@ -0,0 +1,41 @@
+#pragma once
+
+// -- std headers
+#include <memory>
+#include <random>
+
+namespace EVENT {
+  class LCEvent ;
+}
+
+namespace lceve {
+
+  /**
+   *  @brief  SyntheticEvent class
+   *  Creates synthetic LCIO events for benchmarking the event pipeline
+   *  without input file. An event of size n holds n MC particles
+   *  ('MCParticle'), n tracks ('Tracks') and 10 x n calorimeter hits
+   *  ('CalorimeterHits') with realistic value ranges. Each track is linked
+   *  to one or two MC particles ('TrackMCTruthLink').
+   */
+  class SyntheticEvent {
+  public:
+    /// The MC particle collection name
+    static constexpr const char *fgMCParticleCollection = "MCParticle" ;
+    /// The track collection name
+    static constexpr const char *fgTrackCollection = "Tracks" ;
+    /// The calorimeter hit collection name
+    static constexpr const char *fgCaloHitCollection = "CalorimeterHits" ;
+    /// The track to MC particle relation collection name
+    static constexpr const char *fgTrackTruthCollection = "TrackMCTruthLink" ;
+    /// The number of calorimeter hits per MC particle
+    static constexpr int fgCaloHitsPerObject = 10 ;
+
+  public:
+    SyntheticEvent() = delete ;
+
+    /// Create a synthetic event of the given size
+    static std::unique_ptr<EVENT::LCEvent> Create( int eventNumber, int size, std::mt19937 &generator ) ;
+  };
+
+}
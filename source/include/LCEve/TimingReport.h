@@ -0,0 +1,81 @@
+#pragma once
+
+// -- std headers
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+
+// -- lceve headers
+#include <LCEve/json.h>
+
+namespace lceve {
+
+  /**
+   *  @brief  TimingReport class
+   *  Records the wall-clock time of named phases (e.g. the startup phases).
+   *  Phases can overlap and be recorded from different threads.
+   */
+  class TimingReport {
+  public:
+    using Clock = std::chrono::steady_clock ;
+
+    /// A recorded phase, times in seconds from the report creation
+    struct Phase {
+      /// The phase name
+      std::string     fName {} ;
+      /// The start time
+      double          fStart {0.} ;
+      /// The phase duration
+      double          fDuration {0.} ;
+    };
+
+    /**
+     *  @brief  Scope class
+     *  Records a phase from construction to destruction
+     */
+    class Scope {
+    public:
+      Scope() = delete ;
+      Scope( const Scope & ) = delete ;
+      Scope &operator =( const Scope & ) = delete ;
+      /// Constructor with the report and the phase name
+      Scope( TimingReport &report, const std::string &name ) ;
+      /// Destructor. Records the phase
+      ~Scope() ;
+
+    private:
+      TimingReport           &fReport ;
+      std::string             fName {} ;
+      Clock::time_point       fStart {} ;
+    };
+
+  public:
+    TimingReport( const TimingReport & ) = delete ;
+    TimingReport &operator =( const TimingReport & ) = delete ;
+    /// Constructor. The report time origin is set to now
+    TimingReport() ;
+
+    /// Record a phase
+    void AddPhase( const std::string &name, Clock::time_point start, Clock::time_point end ) ;
+    /// Get the recorded phases, ordered by start time
+    std::vector<Phase> GetPhases() const ;
+    /// Get the time elapsed since the report creation, in seconds
+    double GetElapsed() const ;
+
+    /// Print the report
+    void Print( std::ostream &out ) const ;
+    /// Convert the report to json
+    nlohmann::json ToJson() const ;
+
+  private:
+    /// The time origin
+    const Clock::time_point           fOrigin {} ;
+    /// Protects the phase list
+    mutable std::mutex                fMutex {} ;
+    /// The recorded phases
+    std::vector<Phase>                fPhases {} ;
+  };
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+// -- std headers
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+namespace lceve {
+
+  /**
+   *  @brief  Tracer class
+   *  Optional span instrumentation of the event display pipeline, written
+   *  as Chrome trace-event json (chrome://tracing, Perfetto UI).
+   *  Spans are recorded in per-thread buffers and merged on write. When the
+   *  tracer is disabled, a span costs a single relaxed atomic load.
+   *  Use the LCEVE_TRACE_SCOPE(name) macro to trace the enclosing scope.
+   */
+  class Tracer {
+  public:
+    using Clock = std::chrono::steady_clock ;
+
+    /**
+     *  @brief  Span class
+     *  Records a complete event from construction to destruction
+     */
+    class Span {
+    public:
+      Span() = delete ;
+      Span( const Span & ) = delete ;
+      Span &operator =( const Span & ) = delete ;
+      /// Constructor with a static span name
+      Span( const char *name ) ;
+      /// Constructor with a dynamic span name. Copied only if the tracer is enabled
+      Span( const std::string &name ) ;
+      /// Destructor. Records the span
+      ~Span() ;
+
+    private:
+      const char             *fName {nullptr} ;
+      std::string             fDynamicName {} ;
+      Clock::time_point       fStart {} ;
+      bool                    fEnabled {false} ;
+    };
+
+  public:
+    Tracer() = delete ;
+
+    /// Enable tracing. The trace is written to the file on Write()
+    static void Enable( const std::string &fileName ) ;
+    /// Whether the tracing is enabled
+    static bool IsEnabled() ;
+    /// Write the recorded spans of all threads to the trace file
+    static void Write() ;
+
+  private:
+    /// Record a span in the current thread buffer
+    static void Record( const char *name, const std::string &dynamicName, Clock::time_point start, Clock::time_point end ) ;
+
+  private:
+    static std::atomic<bool>          fgEnabled ;
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  inline bool Tracer::IsEnabled() {
+    return fgEnabled.load( std::memory_order_relaxed ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline Tracer::Span::Span( const char *name ) :
+    fName(name),
+    fEnabled(Tracer::IsEnabled()) {
+    if( fEnabled ) {
+      fStart = Clock::now() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline Tracer::Span::Span( const std::string &name ) :
+    fEnabled(Tracer::IsEnabled()) {
+    if( fEnabled ) {
+      fDynamicName = name ;
+      fStart = Clock::now() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline Tracer::Span::~Span() {
+    if( fEnabled ) {
+      Tracer::Record( fName, fDynamicName, fStart, Clock::now() ) ;
+    }
+  }
+
+}
+
+#define LCEVE_TRACE_CONCAT_IMPL( a, b ) a##b
+#define LCEVE_TRACE_CONCAT( a, b ) LCEVE_TRACE_CONCAT_IMPL( a, b )
+/// Trace the enclosing scope under the given name
+#define LCEVE_TRACE_SCOPE( name ) lceve::Tracer::Span LCEVE_TRACE_CONCAT( lceveTraceSpan, __LINE__ )( name )
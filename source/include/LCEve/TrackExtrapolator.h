@@ -0,0 +1,69 @@
+#pragma once
+
+// -- lceve headers
+#include <LCEve/EventArena.h>
+
+// -- root headers
+#include <ROOT/REveVector.hxx>
+
+// -- std headers
+#include <cstddef>
+
+namespace lceve {
+
+  /**
+   *  @brief  TrackExtrapolator class
+   *  Batched extrapolation of tracks to the calorimeter face, modelled as
+   *  a cylinder (barrel inner radius, endcap inner z) in a uniform field.
+   *  Tracks are stored as structure of arrays and all intersections are
+   *  computed in a single branch-light loop, without per-track helix objects.
+   *  All lengths in cm, momenta in GeV and field in Tesla.
+   */
+  class TrackExtrapolator {
+  public:
+    /// The conversion constant from field (T) times radius (cm) to momentum (GeV)
+    static constexpr double fgMomentumFactor = 0.299792458e-2 ;
+
+  public:
+    TrackExtrapolator() = default ;
+    ~TrackExtrapolator() = default ;
+
+    /// Constructor with the memory resource of the track arrays
+    TrackExtrapolator( std::pmr::memory_resource *resource ) ;
+
+    /// Reserve memory for n tracks
+    void Reserve( std::size_t n ) ;
+    /// Add a track from a reference point, the momentum at this point and its charge
+    void AddTrack( const ROOT::REveVectorT<float> &position, const ROOT::REveVectorT<float> &momentum, int charge ) ;
+    /// Remove all tracks and results
+    void Clear() ;
+    /// Get the number of tracks
+    std::size_t GetSize() const ;
+
+    /// Extrapolate all tracks to the calorimeter face of radius faceR and half length faceZ
+    /// in the uniform field bz, following at most maxOrbs turns.
+    /// Returns the number of tracks reaching the face
+    std::size_t Extrapolate( double faceR, double faceZ, double bz, double maxOrbs ) ;
+
+    /// Whether the track i reaches the calorimeter face. Valid after Extrapolate()
+    bool HasIntersection( std::size_t i ) const ;
+    /// Get the calorimeter face intersection of the track i. Valid after Extrapolate()
+    ROOT::REveVectorT<float> GetIntersection( std::size_t i ) const ;
+
+  private:
+    // Inputs
+    ArenaVector<float>            fX {} ;
+    ArenaVector<float>            fY {} ;
+    ArenaVector<float>            fZ {} ;
+    ArenaVector<float>            fPx {} ;
+    ArenaVector<float>            fPy {} ;
+    ArenaVector<float>            fPz {} ;
+    ArenaVector<float>            fCharge {} ;
+    // Outputs
+    ArenaVector<float>            fOutX {} ;
+    ArenaVector<float>            fOutY {} ;
+    ArenaVector<float>            fOutZ {} ;
+    ArenaVector<unsigned char>    fValid {} ;
+  };
+
+}
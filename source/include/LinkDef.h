@@ -3,3 +3,4 @@
 #pragma link C++ class lceve::IEventNavigator+ ;
 #pragma link C++ class lceve::EventNavigator+ ;
 #pragma link C++ class lceve::EventDisplay+ ;
+#pragma link C++ class lceve::InstancedGeoShape+ ;
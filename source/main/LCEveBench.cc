@@ -0,0 +1,250 @@
+// -- lceve headers
+#include <LCEve/EventDisplay.h>
+#include <LCEve/EventConverter.h>
+#include <LCEve/MemoryMonitor.h>
+#include <LCEve/SyntheticEvent.h>
+#include <LCEve/CompactEncoding.h>
+#include <LCEve/json.h>
+
+// -- root headers
+#include <ROOT/REveManager.hxx>
+#include <ROOT/REveScene.hxx>
+#include <ROOT/REveRenderData.hxx>
+
+// -- lcio headers
+#include <MT/LCReader.h>
+#include <EVENT/LCEvent.h>
+
+// -- tclap headers
+#include <tclap/CmdLine.h>
+#include <tclap/ValueArg.h>
+
+// -- std headers
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+  using Clock = std::chrono::steady_clock ;
+
+  /// Seconds elapsed since the given time point
+  double ElapsedSeconds( Clock::time_point start ) {
+    return std::chrono::duration<double>( Clock::now() - start ).count() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Nearest-rank percentile of a list of samples
+  double Percentile( std::vector<double> samples, double percent ) {
+    if( samples.empty() ) {
+      return 0. ;
+    }
+    std::sort( samples.begin(), samples.end() ) ;
+    auto rank = static_cast<std::size_t>( std::ceil( percent / 100. * samples.size() ) ) ;
+    return samples[ std::min( std::max( rank, std::size_t(1) ), samples.size() ) - 1 ] ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Size of the render data of an element tree, in bytes
+  std::size_t RenderDataBytes( ROOT::REveElement *element ) {
+    std::size_t bytes = 0 ;
+    auto renderData = element->GetRenderData() ;
+    if( nullptr != renderData ) {
+      bytes += renderData->GetBinarySize() ;
+    }
+    for( auto child : element->RefChildren() ) {
+      bytes += RenderDataBytes( child ) ;
+    }
+    return bytes ;
+  }
+
+}
+
+int main (int argc, const char **argv) {
+
+  TCLAP::CmdLine cmd("LCEveBench: headless throughput benchmark of the LCEve event pipeline", ' ', "master") ;
+
+  TCLAP::MultiArg<std::string> lcioFilesArg( "f", "lcio-file",
+    "The input LCIO file(s)", false, "vector<string>") ;
+  cmd.add( lcioFilesArg ) ;
+
+  TCLAP::ValueArg<std::string> compactFileArg( "g", "geometry",
+    "The DD4hep geometry compact file", true, "", "string") ;
+  cmd.add( compactFileArg ) ;
+
+  TCLAP::ValueArg<std::string> configArg( "c", "config",
+    "The event display config file name", true, "", "string") ;
+  cmd.add( configArg ) ;
+
+  TCLAP::ValueArg<int> nEventsArg( "N", "events",
+    "The maximum number of events to process (file) or the number of synthetic events", false, 100, "int") ;
+  cmd.add( nEventsArg ) ;
+
+  TCLAP::ValueArg<int> nWarmupArg( "w", "warmup",
+    "The number of events processed before starting the measurements", false, 2, "int") ;
+  cmd.add( nWarmupArg ) ;
+
+  TCLAP::ValueArg<int> syntheticSizeArg( "S", "synthetic",
+    "Process synthetic events with the given number of particles and tracks (10 times more calorimeter hits) instead of a LCIO file", false, 0, "int") ;
+  cmd.add( syntheticSizeArg ) ;
+
+  TCLAP::ValueArg<std::string> outputArg( "o", "output",
+    "The output json report file name. Printed on standard output if not set", false, "", "string") ;
+  cmd.add( outputArg ) ;
+
+  TCLAP::SwitchArg noGeometryCacheArg( "n", "no-geometry-cache",
+    "Do not read or write the converted geometry cache", false) ;
+  cmd.add( noGeometryCacheArg ) ;
+
+  TCLAP::ValueArg<std::string> compactEncodingArg( "e", "compact-encoding",
+    "Send the event positions quantised to this resolution (cm) and delta-encoded", false, "", "string") ;
+  cmd.add( compactEncodingArg ) ;
+
+  cmd.parse( argc, argv ) ;
+
+  if( lcioFilesArg.getValue().empty() and (syntheticSizeArg.getValue() <= 0) ) {
+    std::cerr << "ERROR: Either LCIO file(s) (-f) or synthetic events (-S) are required" << std::endl ;
+    return 1 ;
+  }
+
+  // Set up the event display in server mode, without web client
+  std::vector<const char*> displayArgs = {
+    argv[0], "-s", "-g", compactFileArg.getValue().c_str(), "-c", configArg.getValue().c_str()
+  } ;
+  if( noGeometryCacheArg.getValue() ) {
+    displayArgs.push_back( "-n" ) ;
+  }
+  if( compactEncodingArg.isSet() ) {
+    displayArgs.push_back( "-e" ) ;
+    displayArgs.push_back( compactEncodingArg.getValue().c_str() ) ;
+  }
+  lceve::EventDisplay eventDisplay ;
+  eventDisplay.Init( displayArgs.size(), displayArgs.data() ) ;
+  auto eventConverter = eventDisplay.GetEventConverter() ;
+  // No client: the conversion and the serialisation are measured separately
+  eventConverter->SetProgressiveStreaming( false ) ;
+  auto destroyElements = [&](){
+    for( auto &scene : eventConverter->GetScenes() ) {
+      scene.second->DestroyElements() ;
+    }
+  } ;
+
+  // Event source: LCIO file(s) read in sequence or synthetic events
+  std::unique_ptr<MT::LCReader> reader {nullptr} ;
+  if( not lcioFilesArg.getValue().empty() ) {
+    reader = std::make_unique<MT::LCReader>( 0 ) ;
+    reader->open( lcioFilesArg.getValue() ) ;
+  }
+  std::mt19937 generator( 42 ) ;
+  int eventNumber = 0 ;
+  auto nextEvent = [&]() -> std::unique_ptr<EVENT::LCEvent> {
+    if( nullptr != reader ) {
+      return reader->readNextEvent() ;
+    }
+    return lceve::SyntheticEvent::Create( eventNumber, syntheticSizeArg.getValue(), generator ) ;
+  } ;
+
+  // Run the pipeline: read, convert, serialise the render data as for the clients
+  std::map<std::string, std::vector<double>> stageSeconds {} ;
+  std::size_t renderDataBytes = 0 ;
+  std::size_t compactRawBytes = 0 ;
+  std::size_t compactEncodedBytes = 0 ;
+  double totalSeconds = 0. ;
+  const int nWarmup = std::max( 0, nWarmupArg.getValue() ) ;
+  const int nEvents = nEventsArg.getValue() ;
+  for( ; eventNumber < nWarmup + nEvents ; ++eventNumber ) {
+    const auto eventStart = Clock::now() ;
+    auto start = Clock::now() ;
+    auto event = nextEvent() ;
+    if( nullptr == event ) {
+      break ;
+    }
+    const double readTime = ElapsedSeconds( start ) ;
+
+    start = Clock::now() ;
+    destroyElements() ;
+    const double teardownTime = ElapsedSeconds( start ) ;
+
+    start = Clock::now() ;
+    lceve::CompactEncoding::ResetCounters() ;
+    eventConverter->VisualizeEvent( event.get() ) ;
+    const double convertTime = ElapsedSeconds( start ) ;
+
+    start = Clock::now() ;
+    for( auto &scene : eventConverter->GetScenes() ) {
+      scene.second->StreamElements() ;
+    }
+    const double serialiseTime = ElapsedSeconds( start ) ;
+
+    const double eventTime = ElapsedSeconds( eventStart ) ;
+    if( eventNumber < nWarmup ) {
+      continue ;
+    }
+    stageSeconds["read"].push_back( readTime ) ;
+    stageSeconds["teardown"].push_back( teardownTime ) ;
+    stageSeconds["convert"].push_back( convertTime ) ;
+    stageSeconds["serialise"].push_back( serialiseTime ) ;
+    stageSeconds["event"].push_back( eventTime ) ;
+    for( auto &scene : eventConverter->GetScenes() ) {
+      renderDataBytes += RenderDataBytes( scene.second ) ;
+    }
+    compactRawBytes += lceve::CompactEncoding::GetRawBytes() ;
+    compactEncodedBytes += lceve::CompactEncoding::GetEncodedBytes() ;
+    totalSeconds += eventTime ;
+  }
+  destroyElements() ;
+
+  // Build and write the report
+  const std::size_t nMeasured = stageSeconds["event"].size() ;
+  nlohmann::json report = {} ;
+  report["config"] = configArg.getValue() ;
+  report["geometry"] = compactFileArg.getValue() ;
+  report["source"] = (nullptr != reader) ? "lcio" : "synthetic" ;
+  // EventConverter::VisualizeEvent is called directly: the previous event is destroyed
+  // synchronously ('teardown' stage), not deferred to the event loop as in LCEve
+  report["pipeline"] = "EventConverter::VisualizeEvent, synchronous teardown" ;
+  if( nullptr == reader ) {
+    report["syntheticSize"] = syntheticSizeArg.getValue() ;
+  }
+  report["warmupEvents"] = nWarmup ;
+  report["events"] = nMeasured ;
+  report["eventsPerSecond"] = (totalSeconds > 0.) ? nMeasured / totalSeconds : 0. ;
+  report["renderDataBytesPerEvent"] = (nMeasured > 0) ? renderDataBytes / nMeasured : 0 ;
+  if( lceve::CompactEncoding::IsEnabled() ) {
+    report["compactEncoding"] = {
+      { "resolution", lceve::CompactEncoding::GetResolution() },
+      { "rawBytesPerEvent", (nMeasured > 0) ? compactRawBytes / nMeasured : 0 },
+      { "encodedBytesPerEvent", (nMeasured > 0) ? compactEncodedBytes / nMeasured : 0 }
+    } ;
+  }
+  report["peakResidentBytes"] = lceve::MemoryMonitor::GetPeakResidentBytes() ;
+  for( const auto &stage : stageSeconds ) {
+    double sum = 0. ;
+    for( auto t : stage.second ) {
+      sum += t ;
+    }
+    report["stages"][stage.first] = {
+      { "mean", stage.second.empty() ? 0. : sum / stage.second.size() },
+      { "p50", Percentile( stage.second, 50. ) },
+      { "p99", Percentile( stage.second, 99. ) },
+      { "max", Percentile( stage.second, 100. ) }
+    } ;
+  }
+
+  if( outputArg.getValue().empty() ) {
+    std::cout << report.dump( 2 ) << std::endl ;
+  }
+  else {
+    std::ofstream output( outputArg.getValue() ) ;
+    output << report.dump( 2 ) << std::endl ;
+    std::cout << "Benchmark report written in " << outputArg.getValue() << std::endl ;
+  }
+  return 0 ;
+}
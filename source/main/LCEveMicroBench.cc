@@ -0,0 +1,602 @@
+// -- lceve headers
+#include <LCEve/EventDisplay.h>
+#include <LCEve/Geometry.h>
+#include <LCEve/HelixClass.h>
+#include <LCEve/LCObjectFactory.h>
+#include <LCEve/EveElementFactory.h>
+#include <LCEve/DrawAttributes.h>
+#include <LCEve/LCIOHelper.h>
+#include <LCEve/SyntheticEvent.h>
+#include <LCEve/TrackExtrapolator.h>
+#include <LCEve/EigenHelper.h>
+#include <LCEve/RelationIndex.h>
+#include <LCEve/CompactEncoding.h>
+#include <LCEve/json.h>
+
+// -- root headers
+#include <ROOT/REveTrackPropagator.hxx>
+#include <ROOT/REveTrack.hxx>
+#include <TMatrixDEigen.h>
+#include <TMatrixDSym.h>
+#include <TVectorD.h>
+
+// -- lcio headers
+#include <EVENT/LCEvent.h>
+#include <EVENT/LCCollection.h>
+#include <UTIL/LCRelationNavigator.h>
+
+// -- tclap headers
+#include <tclap/CmdLine.h>
+#include <tclap/ValueArg.h>
+
+// -- std headers
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <vector>
+#include <array>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cmath>
+
+namespace {
+
+  using Clock = std::chrono::steady_clock ;
+
+  /// Prevent the compiler from optimizing away a benchmarked result
+  template <typename T>
+  inline void DoNotOptimize( const T &value ) {
+    asm volatile( "" : : "r,m"( value ) : "memory" ) ;
+  }
+
+  /**
+   *  @brief  MicroBench class
+   *  Minimal micro-benchmark harness. Each kernel is run on inputs of
+   *  increasing size, repeated until a minimum measurement time is reached.
+   *  Reports the time per call and per input item.
+   */
+  class MicroBench {
+  public:
+    /// A benchmarked kernel, called with the input size. Returns the number of processed items
+    using Kernel_t = std::function<std::size_t( std::size_t )> ;
+
+    /// Constructor with kernel name filter, minimum time per measurement (seconds) and input sizes
+    MicroBench( const std::string &filter, double minTime, const std::vector<std::size_t> &sizes ) :
+      fFilter(filter),
+      fMinTime(minTime),
+      fSizes(sizes) {
+      /* nop */
+    }
+
+    /// Run a kernel over all input sizes, unless filtered out
+    void Run( const std::string &name, const Kernel_t &kernel ) {
+      if( not fFilter.empty() and (std::string::npos == name.find( fFilter )) ) {
+        return ;
+      }
+      for( auto size : fSizes ) {
+        // warm up caches and lazy initializations
+        kernel( size ) ;
+        std::size_t iterations = 0, items = 0 ;
+        double elapsed = 0. ;
+        const auto start = Clock::now() ;
+        while( elapsed < fMinTime ) {
+          items += kernel( size ) ;
+          ++iterations ;
+          elapsed = std::chrono::duration<double>( Clock::now() - start ).count() ;
+        }
+        const double nsPerCall = 1e9 * elapsed / iterations ;
+        const double nsPerItem = (items > 0) ? 1e9 * elapsed / items : 0. ;
+        std::cout << std::left << std::setw( 40 ) << name
+                  << std::right << std::setw( 8 ) << size
+                  << std::setw( 14 ) << std::fixed << std::setprecision( 1 ) << nsPerCall << " ns/call"
+                  << std::setw( 12 ) << nsPerItem << " ns/item"
+                  << std::setw( 10 ) << iterations << " iterations" << std::endl ;
+        fResults.push_back( {
+          { "kernel", name }, { "size", size }, { "iterations", iterations },
+          { "nsPerCall", nsPerCall }, { "nsPerItem", nsPerItem }
+        } ) ;
+      }
+    }
+
+    /// Get the results as json
+    const nlohmann::json &GetResults() const {
+      return fResults ;
+    }
+
+  private:
+    std::string                 fFilter {} ;
+    double                      fMinTime {0.} ;
+    std::vector<std::size_t>    fSizes {} ;
+    nlohmann::json              fResults = nlohmann::json::array() ;
+  };
+
+  /// Distance of a point to a track polyline
+  double DistanceToTrack( const ROOT::REveVector &point, ROOT::REveTrack *track ) {
+    double distance = std::numeric_limits<double>::max() ;
+    for( int i=1 ; i<track->GetSize() ; ++i ) {
+      const auto &a = track->RefPoint( i-1 ) ;
+      const auto segment = track->RefPoint( i ) - a ;
+      const double length2 = segment.Mag2() ;
+      double t = (length2 > 0.) ? (point - a).Dot( segment ) / length2 : 0. ;
+      t = std::min( 1., std::max( 0., t ) ) ;
+      distance = std::min( distance, double( (a + segment * float(t) - point).Mag() ) ) ;
+    }
+    return distance ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Decompose a vertex covariance matrix (lower triangle) with TMatrixDEigen
+  lceve::EigenHelper::Eigen3 DecomposeWithROOT( const lceve::EigenHelper::SymMatrix3_t &lower ) {
+    TMatrixDSym matrix(3) ;
+    matrix(0, 0) = lower[0] ;
+    matrix(1, 0) = matrix(0, 1) = lower[1] ; matrix(1, 1) = lower[2] ;
+    matrix(2, 0) = matrix(0, 2) = lower[3] ; matrix(2, 1) = matrix(1, 2) = lower[4] ; matrix(2, 2) = lower[5] ;
+    TMatrixDEigen eigen( matrix ) ;
+    const TVectorD values = eigen.GetEigenValues() ;
+    const TMatrixD vectors = eigen.GetEigenVectors() ;
+    lceve::EigenHelper::Eigen3 result {} ;
+    for( int i=0 ; i<3 ; ++i ) {
+      result.fValues[i] = values(i) ;
+      for( int j=0 ; j<3 ; ++j ) {
+        result.fVectors[3*i + j] = vectors(i, j) ;
+      }
+    }
+    return result ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Largest element of |V diag(values) V^T - A| for a decomposition of A,
+  /// relative to the largest element of A
+  double ReconstructionError( const lceve::EigenHelper::SymMatrix3_t &lower, const lceve::EigenHelper::Eigen3 &eigen ) {
+    const double a[3][3] = {
+      { lower[0], lower[1], lower[3] },
+      { lower[1], lower[2], lower[4] },
+      { lower[3], lower[4], lower[5] }
+    } ;
+    double error = 0., scale = 0. ;
+    for( int i=0 ; i<3 ; ++i ) {
+      for( int j=0 ; j<3 ; ++j ) {
+        double sum = 0. ;
+        for( int k=0 ; k<3 ; ++k ) {
+          sum += eigen.fVectors[3*i + k] * eigen.fValues[k] * eigen.fVectors[3*j + k] ;
+        }
+        error = std::max( error, std::fabs( sum - a[i][j] ) ) ;
+        scale = std::max( scale, std::fabs( a[i][j] ) ) ;
+      }
+    }
+    return (scale > 0.) ? error / scale : error ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// The indices of the eigen values in increasing order
+  std::array<int,3> EigenOrder( const lceve::EigenHelper::Eigen3 &eigen ) {
+    std::array<int,3> order = { 0, 1, 2 } ;
+    std::sort( order.begin(), order.end(), [&eigen]( int lhs, int rhs ) {
+      return eigen.fValues[lhs] < eigen.fValues[rhs] ;
+    }) ;
+    return order ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Sine of the angle between the eigen vector i of a and the eigen vector j of b.
+  /// Insensitive to the sign of the vectors
+  double EigenVectorSine( const lceve::EigenHelper::Eigen3 &a, int i, const lceve::EigenHelper::Eigen3 &b, int j ) {
+    const ROOT::REveVectorD u( a.fVectors[i], a.fVectors[3 + i], a.fVectors[6 + i] ) ;
+    const ROOT::REveVectorD v( b.fVectors[j], b.fVectors[3 + j], b.fVectors[6 + j] ) ;
+    const double norms = u.Mag() * v.Mag() ;
+    return (norms > 0.) ? u.Cross( v ).Mag() / norms : 1. ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Check a compact encoding round trip: each decoded coordinate must be within half the
+  /// resolution of the input, plus the rounding of the decoded value to float.
+  /// Prints the largest error and the encoded size. Returns false if the round trip fails
+  bool CheckCompactRoundTrip( const std::string &label, const std::vector<float> &positions, float resolution, const std::array<float,3> &origin ) {
+    std::vector<std::uint32_t> words {} ;
+    std::vector<float> decoded {} ;
+    lceve::CompactEncoding::Encode( positions.data(), positions.size() / 3, resolution, origin, words ) ;
+    const bool valid = lceve::CompactEncoding::Decode( words, decoded ) and ( decoded.size() == positions.size() ) ;
+    double maxError = 0. ;
+    std::size_t nErrors = 0 ;
+    for( std::size_t i=0 ; valid and i<positions.size() ; ++i ) {
+      const float magnitude = std::fabs( decoded[i] ) ;
+      const double rounding = std::nextafter( magnitude, std::numeric_limits<float>::infinity() ) - magnitude ;
+      const double error = std::fabs( static_cast<double>( decoded[i] ) - positions[i] ) ;
+      nErrors += ( error > 0.5 * resolution * ( 1. + 1e-9 ) + 0.5 * rounding ) ? 1 : 0 ;
+      maxError = std::max( maxError, error ) ;
+    }
+    std::cout << "Compact encoding, " << label << " (" << positions.size() / 3 << " points, resolution " << resolution << " cm): "
+              << ( valid ? "valid" : "INVALID" ) << ", max error " << maxError << " cm, "
+              << words.size() * sizeof(std::uint32_t) << " bytes vs " << positions.size() * sizeof(float) << " bytes" << std::endl ;
+    if( valid and ( nErrors > 0 ) ) {
+      std::cout << "ERROR: Compact encoding, " << label << ": " << nErrors << " coordinates beyond half the resolution" << std::endl ;
+    }
+    return valid and ( 0 == nErrors ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// The synthetic input collections of a given size
+  struct Inputs {
+    std::unique_ptr<EVENT::LCEvent>       fEvent {nullptr} ;
+    std::vector<EVENT::Track*>            fTracks {} ;
+    std::vector<EVENT::MCParticle*>       fMCParticles {} ;
+    std::vector<EVENT::CalorimeterHit*>   fCaloHits {} ;
+    EVENT::LCCollection                  *fTrackTruthLinks {nullptr} ;
+    /// The calorimeter hit positions (cm), x, y, z consecutive
+    std::vector<float>                    fCaloHitPositions {} ;
+    /// Random vertex covariance matrices (cm^2)
+    std::vector<lceve::EigenHelper::SymMatrix3_t> fCovariances {} ;
+  };
+
+}
+
+int main (int argc, const char **argv) {
+
+  TCLAP::CmdLine cmd("LCEveMicroBench: micro-benchmarks of the LCEve conversion kernels", ' ', "master") ;
+
+  TCLAP::ValueArg<std::string> compactFileArg( "g", "geometry",
+    "The DD4hep geometry compact file (B field)", true, "", "string") ;
+  cmd.add( compactFileArg ) ;
+
+  TCLAP::ValueArg<std::string> configArg( "c", "config",
+    "The event display config file name", true, "", "string") ;
+  cmd.add( configArg ) ;
+
+  TCLAP::ValueArg<std::string> filterArg( "k", "kernel",
+    "Only run the kernels whose name contains this string", false, "", "string") ;
+  cmd.add( filterArg ) ;
+
+  TCLAP::ValueArg<double> minTimeArg( "t", "min-time",
+    "The minimum measurement time per kernel and input size (seconds)", false, 0.2, "double") ;
+  cmd.add( minTimeArg ) ;
+
+  TCLAP::MultiArg<int> sizesArg( "S", "size",
+    "The input sizes (default: 10, 100, 1000, 10000)", false, "int") ;
+  cmd.add( sizesArg ) ;
+
+  TCLAP::ValueArg<std::string> outputArg( "o", "output",
+    "The output json result file name", false, "", "string") ;
+  cmd.add( outputArg ) ;
+
+  cmd.parse( argc, argv ) ;
+
+  std::vector<std::size_t> sizes = { 10, 100, 1000, 10000 } ;
+  if( sizesArg.isSet() ) {
+    sizes.assign( sizesArg.getValue().begin(), sizesArg.getValue().end() ) ;
+  }
+
+  // The event display provides the B field and the propagators
+  std::vector<const char*> displayArgs = {
+    argv[0], "-s", "-g", compactFileArg.getValue().c_str(), "-c", configArg.getValue().c_str()
+  } ;
+  lceve::EventDisplay eventDisplay ;
+  eventDisplay.Init( displayArgs.size(), displayArgs.data() ) ;
+  auto geometry = eventDisplay.GetGeometry() ;
+  auto bfield = geometry->GetBField() ;
+  const float bz = bfield->GetField( 0.f, 0.f, 0.f ).fZ ;
+
+  // Create the synthetic inputs once per size
+  std::mt19937 generator( 42 ) ;
+  std::map<std::size_t, Inputs> inputs {} ;
+  for( auto size : sizes ) {
+    auto &input = inputs[size] ;
+    input.fEvent = lceve::SyntheticEvent::Create( 0, size, generator ) ;
+    input.fTracks = lceve::LCIOHelper::CollectionAsVector<EVENT::Track>(
+      input.fEvent->getCollection( lceve::SyntheticEvent::fgTrackCollection ) ) ;
+    input.fMCParticles = lceve::LCIOHelper::CollectionAsVector<EVENT::MCParticle>(
+      input.fEvent->getCollection( lceve::SyntheticEvent::fgMCParticleCollection ) ) ;
+    input.fCaloHits = lceve::LCIOHelper::CollectionAsVector<EVENT::CalorimeterHit>(
+      input.fEvent->getCollection( lceve::SyntheticEvent::fgCaloHitCollection ) ) ;
+    input.fTrackTruthLinks = input.fEvent->getCollection( lceve::SyntheticEvent::fgTrackTruthCollection ) ;
+    for( auto caloHit : input.fCaloHits ) {
+      auto position = caloHit->getPosition() ;
+      input.fCaloHitPositions.insert( input.fCaloHitPositions.end(), { position[0]*0.1f, position[1]*0.1f, position[2]*0.1f } ) ;
+    }
+    // A = B B^T is symmetric positive semi-definite
+    std::normal_distribution<float> error( 0.f, 1e-3f ) ;
+    input.fCovariances.resize( size ) ;
+    for( auto &covariance : input.fCovariances ) {
+      float b[3][3] ;
+      for( auto &row : b ) {
+        for( auto &element : row ) {
+          element = error( generator ) ;
+        }
+      }
+      auto dot = [&b]( int i, int j ) {
+        return b[i][0]*b[j][0] + b[i][1]*b[j][1] + b[i][2]*b[j][2] ;
+      } ;
+      covariance = { dot(0, 0), dot(1, 0), dot(1, 1), dot(2, 0), dot(2, 1), dot(2, 2) } ;
+    }
+  }
+
+  lceve::LCObjectFactory lcFactory( &eventDisplay ) ;
+  lceve::EveElementFactory eveFactory( &eventDisplay ) ;
+  MicroBench bench( filterArg.getValue(), minTimeArg.getValue(), sizes ) ;
+  // The number of failed validations, the exit code is non zero if any
+  std::size_t nFailures = 0 ;
+
+  bench.Run( "HelixClass::Initialize_Canonical", [&]( std::size_t size ){
+    HelixClass helix ;
+    for( auto track : inputs[size].fTracks ) {
+      auto state = track->getTrackState( EVENT::TrackState::AtIP ) ;
+      helix.Initialize_Canonical( state->getPhi(), state->getD0(), state->getZ0(),
+        state->getOmega(), state->getTanLambda(), bz ) ;
+      DoNotOptimize( helix.getMomentum()[0] ) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "LCObjectFactory::ConvertTrack", [&]( std::size_t size ){
+    for( auto track : inputs[size].fTracks ) {
+      auto parameters = lcFactory.ConvertTrack( track ) ;
+      DoNotOptimize( parameters ) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "LCObjectFactory::ConvertCaloHits", [&]( std::size_t size ){
+    auto &caloHits = inputs[size].fCaloHits ;
+    auto parameters = lcFactory.ConvertCaloHits( caloHits ) ;
+    DoNotOptimize( parameters.data() ) ;
+    return caloHits.size() ;
+  }) ;
+
+  bench.Run( "LCObjectFactory::ConvertMCParticle", [&]( std::size_t size ){
+    for( auto mcp : inputs[size].fMCParticles ) {
+      auto parameters = lcFactory.ConvertMCParticle( mcp ) ;
+      DoNotOptimize( parameters ) ;
+    }
+    return size ;
+  }) ;
+
+  // Includes the propagation and the track container destruction
+  std::vector<lceve::TrackParameters> trackParameters {} ;
+  bench.Run( "EveElementFactory::CreateTrack", [&]( std::size_t size ){
+    trackParameters.clear() ;
+    for( auto track : inputs[size].fTracks ) {
+      trackParameters.push_back( lcFactory.ConvertTrack( track ) ) ;
+    }
+    auto propagator = geometry->GetTrackPropagator() ;
+    auto container = eveFactory.CreateTrackContainer() ;
+    for( auto &parameters : trackParameters ) {
+      container->AddElement( eveFactory.CreateTrack( propagator, parameters ) ) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "EveElementFactory::CreateTrack(helix)", [&]( std::size_t size ){
+    trackParameters.clear() ;
+    for( auto track : inputs[size].fTracks ) {
+      trackParameters.push_back( lcFactory.ConvertTrack( track ) ) ;
+      trackParameters.back().fRenderMode = lceve::TrackRenderMode::Helix ;
+    }
+    auto propagator = geometry->GetTrackPropagator() ;
+    auto container = eveFactory.CreateTrackContainer() ;
+    for( auto &parameters : trackParameters ) {
+      container->AddElement( eveFactory.CreateTrack( propagator, parameters ) ) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "TrackExtrapolator::Extrapolate", [&]( std::size_t size ){
+    lceve::TrackExtrapolator extrapolator ;
+    extrapolator.Reserve( size ) ;
+    for( auto track : inputs[size].fTracks ) {
+      auto parameters = lcFactory.ConvertTrack( track ) ;
+      extrapolator.AddTrack( parameters.fReferencePoint.value(), parameters.fMomentum.value(), parameters.fCharge.value() ) ;
+    }
+    auto nHits = extrapolator.Extrapolate( geometry->GetCalorimeterFaceR(), geometry->GetCalorimeterFaceZ(), -bz, 5. ) ;
+    DoNotOptimize( nHits ) ;
+    return size ;
+  }) ;
+
+  // Validate the analytic helix against the propagator: largest distance
+  // of the propagator points to the helix polyline. The polyline is within
+  // HelixSagittaTolerance of the helix, the same again is allowed for the
+  // propagator steps. Very stiff tracks are drawn as straight lines: the
+  // sagitta of the helix over the line length is added to their bound
+  if( filterArg.getValue().empty() or (std::string::npos != std::string( "EveElementFactory::CreateTrack(helix)" ).find( filterArg.getValue() )) ) {
+    auto propagator = geometry->GetTrackPropagator() ;
+    double maxDistance = 0., maxBound = 0. ;
+    std::size_t nPropagatorPoints = 0, nHelixPoints = 0, nFailedTracks = 0 ;
+    for( auto track : inputs[sizes.front()].fTracks ) {
+      auto parameters = lcFactory.ConvertTrack( track ) ;
+      std::unique_ptr<ROOT::REveTrack> stepped( eveFactory.CreateTrack( propagator, parameters ) ) ;
+      parameters.fRenderMode = lceve::TrackRenderMode::Helix ;
+      std::unique_ptr<ROOT::REveTrack> analytic( eveFactory.CreateTrack( propagator, parameters ) ) ;
+      double bound = 2. * lceve::EveElementFactory::HelixSagittaTolerance ;
+      if( analytic->GetSize() == 2 ) {
+        const double radius = parameters.fMomentum.value().Perp() / ( lceve::TrackExtrapolator::fgMomentumFactor * std::fabs( bz ) ) ;
+        const double length = ( analytic->RefPoint( 1 ) - analytic->RefPoint( 0 ) ).Mag() ;
+        bound += length * length / ( 8. * radius ) ;
+      }
+      double distance = 0. ;
+      for( int i=0 ; i<stepped->GetSize() ; ++i ) {
+        distance = std::max( distance, DistanceToTrack( stepped->RefPoint( i ), analytic.get() ) ) ;
+      }
+      nFailedTracks += ( distance > bound ) ? 1 : 0 ;
+      maxDistance = std::max( maxDistance, distance ) ;
+      maxBound = std::max( maxBound, bound ) ;
+      nPropagatorPoints += stepped->GetSize() ;
+      nHelixPoints += analytic->GetSize() ;
+    }
+    std::cout << "Helix vs propagator (" << inputs[sizes.front()].fTracks.size() << " tracks): max distance "
+              << maxDistance << " cm (bound " << 2. * lceve::EveElementFactory::HelixSagittaTolerance << " cm, "
+              << maxBound << " cm for straight lines), points " << nHelixPoints << " (helix) vs "
+              << nPropagatorPoints << " (propagator)" << std::endl ;
+    if( nFailedTracks > 0 ) {
+      std::cout << "ERROR: Helix vs propagator: " << nFailedTracks << " tracks farther than their bound" << std::endl ;
+      ++nFailures ;
+    }
+  }
+
+  std::vector<lceve::EigenHelper::Eigen3> eigens {} ;
+  bench.Run( "EigenHelper::DecomposeBatch", [&]( std::size_t size ){
+    auto &covariances = inputs[size].fCovariances ;
+    eigens.resize( covariances.size() ) ;
+    lceve::EigenHelper::DecomposeBatch( covariances.data(), covariances.size(), eigens.data() ) ;
+    DoNotOptimize( eigens.data() ) ;
+    return size ;
+  }) ;
+
+  bench.Run( "TMatrixDEigen", [&]( std::size_t size ){
+    for( auto &covariance : inputs[size].fCovariances ) {
+      auto eigen = DecomposeWithROOT( covariance ) ;
+      DoNotOptimize( eigen ) ;
+    }
+    return size ;
+  }) ;
+
+  // Check the Jacobi solver against TMatrixDEigen (the order may differ). Relative to the
+  // largest eigen value: the eigen values must agree and V diag(values) V^T must give back
+  // the matrix. The eigen vectors must agree up to their sign, within the tolerance scaled
+  // by the gap to the closest eigen value. Vectors of (nearly) degenerate eigen values are
+  // not unique and are not compared
+  if( filterArg.getValue().empty() or (std::string::npos != std::string( "EigenHelper::DecomposeBatch" ).find( filterArg.getValue() )) ) {
+    const double tolerance = 1e-9 ;
+    double maxJacobiError = 0., maxROOTError = 0., maxValueDifference = 0., maxVectorDifference = 0. ;
+    std::size_t nFailedMatrices = 0 ;
+    for( auto &covariance : inputs[sizes.back()].fCovariances ) {
+      auto jacobi = lceve::EigenHelper::Decompose( covariance ) ;
+      auto root = DecomposeWithROOT( covariance ) ;
+      const double jacobiError = ReconstructionError( covariance, jacobi ) ;
+      maxJacobiError = std::max( maxJacobiError, jacobiError ) ;
+      maxROOTError = std::max( maxROOTError, ReconstructionError( covariance, root ) ) ;
+      const auto jacobiOrder = EigenOrder( jacobi ) ;
+      const auto rootOrder = EigenOrder( root ) ;
+      double scale = 0. ;
+      for( auto value : root.fValues ) {
+        scale = std::max( scale, std::fabs( value ) ) ;
+      }
+      if( 0. == scale ) {
+        continue ;
+      }
+      bool failed = ( jacobiError > tolerance ) ;
+      for( int i=0 ; i<3 ; ++i ) {
+        const double valueDifference = std::fabs( jacobi.fValues[ jacobiOrder[i] ] - root.fValues[ rootOrder[i] ] ) / scale ;
+        maxValueDifference = std::max( maxValueDifference, valueDifference ) ;
+        failed = failed or ( valueDifference > tolerance ) ;
+        double gap = std::numeric_limits<double>::max() ;
+        for( int j=0 ; j<3 ; ++j ) {
+          if( j != i ) {
+            gap = std::min( gap, std::fabs( root.fValues[ rootOrder[i] ] - root.fValues[ rootOrder[j] ] ) / scale ) ;
+          }
+        }
+        if( gap < 1e-6 ) {
+          continue ;
+        }
+        const double vectorDifference = EigenVectorSine( jacobi, jacobiOrder[i], root, rootOrder[i] ) ;
+        maxVectorDifference = std::max( maxVectorDifference, vectorDifference * gap ) ;
+        failed = failed or ( vectorDifference * gap > tolerance ) ;
+      }
+      nFailedMatrices += failed ? 1 : 0 ;
+    }
+    std::cout << "Jacobi vs TMatrixDEigen (" << inputs[sizes.back()].fCovariances.size() << " matrices): max relative eigen value difference "
+              << maxValueDifference << ", max eigen vector sine x relative gap " << maxVectorDifference
+              << ", max relative reconstruction error " << maxJacobiError << " (Jacobi) vs "
+              << maxROOTError << " (TMatrixDEigen), tolerance " << tolerance << std::endl ;
+    if( nFailedMatrices > 0 ) {
+      std::cout << "ERROR: Jacobi vs TMatrixDEigen: " << nFailedMatrices << " matrices out of tolerance" << std::endl ;
+      ++nFailures ;
+    }
+  }
+
+  // 100 microns grid anchored at a 5 m detector corner
+  const float compactResolution = 0.01f ;
+  const std::array<float,3> compactOrigin = { -500.f, -500.f, -500.f } ;
+  std::vector<std::uint32_t> compactWords {} ;
+  bench.Run( "CompactEncoding::Encode", [&]( std::size_t size ){
+    auto &positions = inputs[size].fCaloHitPositions ;
+    lceve::CompactEncoding::Encode( positions.data(), positions.size() / 3, compactResolution, compactOrigin, compactWords ) ;
+    DoNotOptimize( compactWords.data() ) ;
+    return positions.size() / 3 ;
+  }) ;
+
+  // Validate the round trip on the calorimeter hits, and on points 50 m apart on a 1e-6 cm
+  // grid: deltas of 5e9 steps, whose zigzag values need more than 32 bits
+  if( filterArg.getValue().empty() or (std::string::npos != std::string( "CompactEncoding::Encode" ).find( filterArg.getValue() )) ) {
+    if( not CheckCompactRoundTrip( "calorimeter hits", inputs[sizes.back()].fCaloHitPositions, compactResolution, compactOrigin ) ) {
+      ++nFailures ;
+    }
+    const std::vector<float> farPositions = {
+      -2500.f, -2500.f, -2500.f,
+      2500.f, 2500.f, 2500.f,
+      -2500.f, 1e-3f, 2500.f,
+      1234.5678f, -2345.678f, -2500.f
+    } ;
+    if( not CheckCompactRoundTrip( "64 bits deltas", farPositions, 1e-6f, { -2500.f, -2500.f, -2500.f } ) ) {
+      ++nFailures ;
+    }
+  }
+
+  // Build once per event, then query the best MC particle of each track in both directions
+  lceve::RelationIndex relationIndex ;
+  bench.Run( "RelationIndex", [&]( std::size_t size ){
+    relationIndex.Build( inputs[size].fTrackTruthLinks ) ;
+    for( auto track : inputs[size].fTracks ) {
+      auto best = relationIndex.GetBestTo( track ) ;
+      DoNotOptimize( best ) ;
+      relationIndex.ForEachFrom( best->fObject, [&]( const lceve::RelationIndex::Link &link ){
+        DoNotOptimize( link.fObject ) ;
+      }) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "LCRelationNavigator", [&]( std::size_t size ){
+    UTIL::LCRelationNavigator navigator( inputs[size].fTrackTruthLinks ) ;
+    for( auto track : inputs[size].fTracks ) {
+      auto &objects = navigator.getRelatedToObjects( track ) ;
+      auto &weights = navigator.getRelatedToWeights( track ) ;
+      auto best = std::distance( weights.begin(), std::max_element( weights.begin(), weights.end() ) ) ;
+      DoNotOptimize( objects[best] ) ;
+      for( auto from : navigator.getRelatedFromObjects( objects[best] ) ) {
+        DoNotOptimize( from ) ;
+      }
+    }
+    return size ;
+  }) ;
+
+  static const std::vector<std::string> colors = {
+    "red", "darkBlue", "brightYellow", "#1f77b4", "255,127,14", "unknown"
+  } ;
+  bench.Run( "ColorHelper::GetColor", [&]( std::size_t size ){
+    for( std::size_t i=0 ; i<size ; ++i ) {
+      auto color = lceve::ColorHelper::GetColor( colors[ i % colors.size() ] ) ;
+      DoNotOptimize( color ) ;
+    }
+    return size ;
+  }) ;
+
+  bench.Run( "BField::GetField", [&]( std::size_t size ){
+    for( auto caloHit : inputs[size].fCaloHits ) {
+      auto position = caloHit->getPosition() ;
+      auto field = bfield->GetField( position[0], position[1], position[2] ) ;
+      DoNotOptimize( field ) ;
+    }
+    return inputs[size].fCaloHits.size() ;
+  }) ;
+
+  if( not outputArg.getValue().empty() ) {
+    std::ofstream output( outputArg.getValue() ) ;
+    output << bench.GetResults().dump( 2 ) << std::endl ;
+    std::cout << "Micro-benchmark results written in " << outputArg.getValue() << std::endl ;
+  }
+  if( nFailures > 0 ) {
+    std::cout << "ERROR: " << nFailures << " validation(s) failed" << std::endl ;
+    return 1 ;
+  }
+  return 0 ;
+}
@@ -1,5 +1,6 @@
 #include <ROOT/REveGeomViewer.hxx>
 #include <TApplication.h>
+#include <TGeoManager.h>
 namespace REX = ROOT::Experimental ;
 
 // -- tclap headers
@@ -8,6 +9,9 @@ namespace REX = ROOT::Experimental ;
 
 #include <DD4hep/Detector.h>
 
+// -- lceve headers
+#include <LCEve/GeometryCache.h>
+
 int main (int argc, const char **argv) {
 
   TCLAP::CmdLine cmd("Linear Collider Geometry Viewer", ' ', "master") ;
@@ -16,15 +20,38 @@ int main (int argc, const char **argv) {
     "The DD4hep geometry compact file", true, "", "string") ;
   cmd.add( compactFileArg ) ;
 
+  TCLAP::ValueArg<std::string> geometryCacheArg( "k", "geometry-cache",
+    "The directory of the converted geometry cache", false, lceve::GeometryCache::DefaultDirectory(), "string") ;
+  cmd.add( geometryCacheArg ) ;
+
+  TCLAP::SwitchArg noGeometryCacheArg( "n", "no-geometry-cache",
+    "Do not read or write the converted geometry cache", false) ;
+  cmd.add( noGeometryCacheArg ) ;
+
   cmd.parse( argc, argv ) ;
 
-  // Load DD4hep compact file
-  auto &detector = dd4hep::Detector::getInstance() ;
-  detector.fromCompact( compactFileArg.getValue() ) ;
-  auto &manager = detector.manager() ;
+  // Load the geometry from the cache if possible, else from the DD4hep compact file
+  TGeoManager *manager = nullptr ;
+  std::unique_ptr<lceve::GeometryCache> cache {nullptr} ;
+  if( not noGeometryCacheArg.getValue() and not geometryCacheArg.getValue().empty() ) {
+    cache = std::make_unique<lceve::GeometryCache>( geometryCacheArg.getValue(), compactFileArg.getValue(), nullptr ) ;
+    if( cache->Open() ) {
+      manager = cache->ReadGeoManager() ;
+    }
+  }
+  if( nullptr == manager ) {
+    auto &detector = dd4hep::Detector::getInstance() ;
+    detector.fromCompact( compactFileArg.getValue() ) ;
+    manager = &detector.manager() ;
+    if( nullptr != cache ) {
+      cache->AddGeoManager( manager ) ;
+      cache->Write() ;
+    }
+  }
+  cache = nullptr ;
 
   TApplication app( "LCGeometryViewer", nullptr, nullptr ) ;
-  auto viewer = std::make_shared<REX::REveGeomViewer>( &manager ) ;
+  auto viewer = std::make_shared<REX::REveGeomViewer>( manager ) ;
   viewer->Show() ;
   app.Run() ;
 
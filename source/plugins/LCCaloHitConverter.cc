@@ -2,6 +2,7 @@
 #include <LCEve/ICollectionConverter.h>
 #include <LCEve/LCObjectFactory.h>
 #include <LCEve/EveElementFactory.h>
+#include <LCEve/EventConverter.h>
 #include <LCEve/LCIOHelper.h>
 #include <LCEve/DrawAttributes.h>
 #include <LCEve/Geometry.h>
@@ -11,6 +12,7 @@
 #include <EVENT/LCCollection.h>
 #include <EVENT/CalorimeterHit.h>
 #include <EVENT/SimCalorimeterHit.h>
+#include <EVENT/RawCalorimeterHit.h>
 #include <UTIL/LCIOTypeInfo.h>
 
 // -- std headers
@@ -68,6 +70,18 @@ namespace lceve {
     eveCaloHitList->SetMarkerStyle( GetParameter<int>( "MarkerStyle" ).value_or( GetDefaultMarkerStyle() ) ) ;
     
     auto params = lcFactory.ConvertCaloHits( caloHits ) ;
+    // Large collections are sent in chunks, highest amplitudes first
+    const int chunkSize = GetParameter<int>( "ChunkSize" ).value_or( 5000 ) ;
+    if( (chunkSize > 0) and (params.size() > static_cast<std::size_t>( chunkSize )) ) {
+      auto chunks = eveFactory.PopulateCaloHitChunks( eveCaloHitList.get(), params, chunkSize ) ;
+      auto eventConverter = this->GetEventDisplay()->GetEventConverter() ;
+      auto container = eveCaloHitList.release() ;
+      eventConverter->StreamElement( container ) ;
+      for( auto &chunk : chunks ) {
+        eventConverter->StreamElement( chunk.release(), container ) ;
+      }
+      return container ;
+    }
     eveFactory.PopulateCaloHits( eveCaloHitList.get(), params ) ;
 
     return eveCaloHitList.release() ;
@@ -84,9 +98,11 @@ namespace lceve {
   
   using LCCalorimeterHitConverter = LCCaloHitConverter<EVENT::CalorimeterHit> ;
   using LCSimCalorimeterHitConverter = LCCaloHitConverter<EVENT::SimCalorimeterHit> ;
+  using LCRawCalorimeterHitConverter = LCCaloHitConverter<EVENT::RawCalorimeterHit> ;
 }
 
 using namespace lceve ;
 // Declare converter plugin
 LCEVE_DECLARE_CONVERTER_NS(lceve, LCCalorimeterHitConverter)
 LCEVE_DECLARE_CONVERTER_NS(lceve, LCSimCalorimeterHitConverter)
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCRawCalorimeterHitConverter)
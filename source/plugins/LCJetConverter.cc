@@ -0,0 +1,105 @@
+// -- lceve headers
+#include <LCEve/ICollectionConverter.h>
+#include <LCEve/LCObjectFactory.h>
+#include <LCEve/EveElementFactory.h>
+#include <LCEve/LCIOHelper.h>
+#include <LCEve/DrawAttributes.h>
+#include <LCEve/Geometry.h>
+#include <LCEve/Factories.h>
+
+// -- lcio headers
+#include <EVENT/LCCollection.h>
+#include <EVENT/ReconstructedParticle.h>
+
+// -- root headers
+#include <ROOT/REveJetCone.hxx>
+
+// -- std headers
+#include <map>
+#include <functional>
+
+namespace lceve {
+  
+  /// Draw jets (EVENT::ReconstructedParticle) as cones up to the calorimeter face.
+  /// The constituents are not converted unless Constituents is set to Always.
+  /// Otherwise they are built on demand, see EventDisplay::ExpandJet()
+  class LCJetConverter : public ICollectionConverter {
+  public:
+    /// Default constructor
+    LCJetConverter() ;
+    
+    ///  Create jet cones out of EVENT::ReconstructedParticle objects
+    ROOT::REveElement* ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) override ;
+    
+  private:
+    using SortFunctionMap_t = LCIOHelper::SortFunctionMap_t<EVENT::ReconstructedParticle> ;    
+    SortFunctionMap_t                fSortFunctions {} ;
+  };
+  
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+  
+  LCJetConverter::LCJetConverter() {
+    fSortFunctions[ "None" ] = [](const EVENT::ReconstructedParticle *, const EVENT::ReconstructedParticle *) {
+      return false ; 
+    } ;
+    fSortFunctions[ "Energy" ] = [](const EVENT::ReconstructedParticle *lhs, const EVENT::ReconstructedParticle *rhs ) { 
+      return lhs->getEnergy() > rhs->getEnergy() ;
+    } ;
+    fSortFunctions[ "Momentum" ] = [](const EVENT::ReconstructedParticle *lhs, const EVENT::ReconstructedParticle *rhs ) { 
+      return ROOT::REveVectorT<float>( lhs->getMomentum() ).Mag() > ROOT::REveVectorT<float>( rhs->getMomentum() ).Mag() ;
+    } ;
+    fSortFunctions[ "Mass" ] = [](const EVENT::ReconstructedParticle *lhs, const EVENT::ReconstructedParticle *rhs ) { 
+      return lhs->getMass() > rhs->getMass() ;
+    } ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  ROOT::REveElement* LCJetConverter::ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) {
+    if( collection->getTypeName() != EVENT::LCIO::RECONSTRUCTEDPARTICLE ) {
+      std::cout << "ERROR: Expected collection type EVENT::LCIO::RECONSTRUCTEDPARTICLE, got " << collection->getTypeName() << std::endl ;
+      return nullptr ;
+    }
+    auto jets = LCIOHelper::CollectionAsVector<EVENT::ReconstructedParticle>( collection ) ;
+    
+    // Jet coloring
+    auto color = GetParameter<std::string>( "Color" ).value_or( "iter" ) ;
+    auto colorFunctor = ColorHelper::GetColorFunction( color ) ;
+    
+    // Sort jets
+    auto sortPolicy = GetParameter<std::string>( "SortPolicy" ).value_or( "Energy" ) ;
+    auto policyIter = fSortFunctions.find( sortPolicy ) ;
+    if( fSortFunctions.end() == policyIter ) {
+      policyIter = fSortFunctions.find( "None" ) ;
+    }
+    std::sort( jets.begin(), jets.end(), policyIter->second ) ;
+    
+    // Constituents: built with the jet (Always) or when the user expands it (OnDemand)
+    auto constituents = GetParameter<std::string>( "Constituents" ).value_or( "OnDemand" ) ;
+    if( ( "Always" != constituents ) and ( "OnDemand" != constituents ) ) {
+      std::cout << "WARNING: Unknown jet constituents mode '" << constituents << "', using OnDemand" << std::endl ;
+    }
+    const bool withConstituents = ( "Always" == constituents ) ;
+    
+    LCObjectFactory lcFactory( this->GetEventDisplay() ) ;
+    EveElementFactory eveFactory( this->GetEventDisplay() ) ;
+    
+    auto eveJetList = eveFactory.CreateJetContainer() ;
+    eveJetList->SetName( name ) ;
+    eveJetList->SetMainColor( kOrange ) ;
+
+    for( auto lcJet : jets ) {
+      auto params = lcFactory.ConvertJet( lcJet, withConstituents ) ;
+      params.fColor = colorFunctor() ;
+      auto eveJet = eveFactory.CreateJet( params ) ;
+      eveJetList->AddElement( eveJet ) ;
+    }
+    return eveJetList.release() ;
+  }
+  
+}
+
+using namespace lceve ;
+// Declare converter plugin
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCJetConverter)
@@ -99,7 +99,7 @@ namespace lceve {
     LCObjectFactory lcFactory( this->GetEventDisplay() ) ;
     EveElementFactory eveFactory( this->GetEventDisplay() ) ;
     
-    auto propagator = GetEventDisplay()->GetGeometry()->CreateMCParticlePropagator() ;
+    auto propagator = GetEventDisplay()->GetGeometry()->GetMCParticlePropagator() ;
     auto eveMCParticleList = eveFactory.CreateMCParticleContainer() ;
     eveMCParticleList->SetName( name ) ;
     eveMCParticleList->SetMainColor( kBlue ) ;
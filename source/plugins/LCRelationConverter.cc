@@ -0,0 +1,165 @@
+// -- lceve headers
+#include <LCEve/ICollectionConverter.h>
+#include <LCEve/EventConverter.h>
+#include <LCEve/ObjectRegistry.h>
+#include <LCEve/RelationIndex.h>
+#include <LCEve/DrawAttributes.h>
+#include <LCEve/Metrics.h>
+#include <LCEve/Objects.h>
+#include <LCEve/Factories.h>
+
+// -- lcio headers
+#include <EVENT/LCCollection.h>
+#include <EVENT/LCIO.h>
+#include <EVENT/LCObject.h>
+
+// -- root headers
+#include <ROOT/REveTrack.hxx>
+
+// -- std headers
+#include <optional>
+
+namespace lceve {
+
+  /**
+   *  @brief  LCRelationConverter class
+   *  Reads LCRelation collections (e.g RecoMCTruthLink, MCTruthRecoLink,
+   *  tracker hit relations) into a relation index of the event converter,
+   *  used to show the truth of a selected object (see EventDisplay::ShowTruth()).
+   *  Nothing is drawn. Once the event is converted, the displayed objects
+   *  of one side can be colored as their best matching object on the other side.
+   *
+   *  Parameters:
+   *  - Colorize: 'auto' (default), 'from', 'to' or 'none'. With 'from', the 'from'
+   *    objects take the color of their 'to' object with the highest weight.
+   *    With 'auto', the side which is not the MC particle side is colored
+   *    (e.g the reco particles of a RecoMCTruthLink), if any
+   */
+  class LCRelationConverter : public ICollectionConverter {
+  public:
+    /// Default constructor
+    LCRelationConverter() = default ;
+
+    /// Build the relation index of the collection
+    ROOT::REveElement* ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) override ;
+
+    /// Color the matched objects, now that all collections are converted
+    void EndOfEvent() override ;
+
+  private:
+    /// The side of the relation to colorize
+    enum class Side {
+      None,
+      From,
+      To
+    };
+
+    /// Get the color of an object: the color of its element if displayed
+    Color_t GetObjectColor( const ObjectRegistry &registry, const EVENT::LCObject *object ) const ;
+
+  private:
+    /// The collection name of the current event
+    std::string                    fCollectionName {} ;
+    /// The side to colorize in the current event
+    Side                           fColorize {Side::None} ;
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  ROOT::REveElement* LCRelationConverter::ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) {
+    fColorize = Side::None ;
+    if( collection->getTypeName() != EVENT::LCIO::LCRELATION ) {
+      std::cout << "ERROR: Expected collection type EVENT::LCIO::LCRELATION, got " << collection->getTypeName() << std::endl ;
+      return nullptr ;
+    }
+    auto eventConverter = GetEventDisplay()->GetEventConverter() ;
+    eventConverter->GetRelationIndex( name ).Build( collection ) ;
+    fCollectionName = name ;
+    auto colorize = GetParameter<std::string>( "Colorize" ).value_or( "auto" ) ;
+    if( colorize == "from" ) {
+      fColorize = Side::From ;
+    }
+    else if( colorize == "to" ) {
+      fColorize = Side::To ;
+    }
+    else if( colorize == "auto" ) {
+      auto &parameters = collection->getParameters() ;
+      if( parameters.getStringVal( "ToType" ) == EVENT::LCIO::MCPARTICLE ) {
+        fColorize = Side::From ;
+      }
+      else if( parameters.getStringVal( "FromType" ) == EVENT::LCIO::MCPARTICLE ) {
+        fColorize = Side::To ;
+      }
+    }
+    else if( colorize != "none" ) {
+      std::cout << "WARNING: Unknown Colorize value '" << colorize << "' for collection " << name << std::endl ;
+    }
+    // relations are not drawn
+    return nullptr ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void LCRelationConverter::EndOfEvent() {
+    if( Side::None == fColorize ) {
+      return ;
+    }
+    auto eventConverter = GetEventDisplay()->GetEventConverter() ;
+    auto &relations = eventConverter->GetRelationIndex( fCollectionName ) ;
+    auto &registry = eventConverter->GetObjectRegistry() ;
+    std::size_t nColored = 0 ;
+    auto colorize = [&]( const EVENT::LCObject *object, const RelationIndex::Link *best ) {
+      if( nullptr == best ) {
+        return ;
+      }
+      bool colorSet = false ;
+      Color_t color = 0 ;
+      registry.ForEachEntry( object, [&]( const ObjectRegistry::Entry &entry ) {
+        // single points of point sets can't have their own color
+        if( entry.fIndex >= 0 ) {
+          return ;
+        }
+        if( not colorSet ) {
+          color = GetObjectColor( registry, best->fObject ) ;
+          colorSet = true ;
+        }
+        entry.fElement->SetMainColor( color ) ;
+        if( auto track = dynamic_cast<EveTrack*>( entry.fElement ) ) {
+          track->SetLineColor( color ) ;
+        }
+      }) ;
+      nColored += colorSet ? 1 : 0 ;
+    } ;
+    if( Side::From == fColorize ) {
+      relations.ForEachFromObject( [&]( const EVENT::LCObject *from ) {
+        colorize( from, relations.GetBestTo( from ) ) ;
+      }) ;
+    }
+    else {
+      relations.ForEachToObject( [&]( const EVENT::LCObject *to ) {
+        colorize( to, relations.GetBestFrom( to ) ) ;
+      }) ;
+    }
+    GetEventDisplay()->GetMetrics().Set( Metrics::Name( "lceve_relation_colored", "collection", fCollectionName ), nColored ) ;
+    fColorize = Side::None ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  Color_t LCRelationConverter::GetObjectColor( const ObjectRegistry &registry, const EVENT::LCObject *object ) const {
+    std::optional<Color_t> color {} ;
+    registry.ForEachEntry( object, [&]( const ObjectRegistry::Entry &entry ) {
+      if( (not color) and (entry.fIndex < 0) ) {
+        color = entry.fElement->GetMainColor() ;
+      }
+    }) ;
+    // not displayed: the default color of the object, as in LCObjectFactory
+    return color.value_or( ColorHelper::RandomColor( object ) ) ;
+  }
+
+}
+
+using namespace lceve ;
+// Declare converter plugin
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCRelationConverter)
@@ -2,16 +2,20 @@
 #include <LCEve/ICollectionConverter.h>
 #include <LCEve/LCObjectFactory.h>
 #include <LCEve/EveElementFactory.h>
+#include <LCEve/EventConverter.h>
 #include <LCEve/LCIOHelper.h>
 #include <LCEve/DrawAttributes.h>
 #include <LCEve/Geometry.h>
 #include <LCEve/Factories.h>
+#include <LCEve/TrackExtrapolator.h>
 
 // -- lcio headers
 #include <EVENT/LCCollection.h>
 
 // -- root headers
 #include <ROOT/REveTrack.hxx>
+#include <ROOT/REveTrackPropagator.hxx>
+#include <ROOT/REvePointSet.hxx>
 
 // -- std headers
 #include <map>
@@ -80,22 +84,67 @@ namespace lceve {
     }
     std::sort( tracks.begin(), tracks.end(), policyIter->second ) ;
     
+    // Track line computation: propagator stepping or analytic helix
+    auto renderModeName = GetParameter<std::string>( "RenderMode" ).value_or( "Propagator" ) ;
+    auto renderMode = TrackRenderMode::Propagator ;
+    if( "Helix" == renderModeName ) {
+      renderMode = TrackRenderMode::Helix ;
+    }
+    else if( "Propagator" != renderModeName ) {
+      std::cout << "WARNING: Unknown track render mode '" << renderModeName << "', using Propagator" << std::endl ;
+    }
+    
     LCObjectFactory lcFactory( this->GetEventDisplay() ) ;
     EveElementFactory eveFactory( this->GetEventDisplay() ) ;
     
-    auto propagator = GetEventDisplay()->GetGeometry()->CreateTrackPropagator() ;
+    auto propagator = GetEventDisplay()->GetGeometry()->GetTrackPropagator() ;
     auto eveTrackList = eveFactory.CreateTrackContainer() ;
     eveTrackList->SetName( name ) ;
     eveTrackList->SetMainColor(kTeal);
 
+    // Calorimeter entry points, extrapolated for all tracks at once
+    const bool caloMarkers = ( "false" != GetParameter<std::string>( "CaloFaceMarkers" ).value_or( "true" ) ) ;
+    TrackExtrapolator extrapolator( lcFactory.GetMemoryResource() ) ;
+    if( caloMarkers ) {
+      extrapolator.Reserve( tracks.size() ) ;
+    }
+
     for( auto lcTrack : tracks ) {
       auto params = lcFactory.ConvertTrack( lcTrack ) ;
+      if( caloMarkers ) {
+        extrapolator.AddTrack( params.fReferencePoint.value(), params.fMomentum.value(), params.fCharge.value() ) ;
+      }
       auto attr = params.fLineAttributes.value_or( LineAttributes {} ) ;
       attr.fColor = colorFunctor() ;
       params.fLineAttributes = attr ;
+      params.fRenderMode = renderMode ;
       auto eveTrack = eveFactory.CreateTrack( propagator, params ) ;
       eveTrackList->AddElement( eveTrack ) ;
     }
+    
+    if( caloMarkers and ( extrapolator.GetSize() > 0 ) ) {
+      auto geometry = GetEventDisplay()->GetGeometry() ;
+      const double bz = -geometry->GetBField()->GetFieldD( 0, 0, 0 )[2] ;
+      const auto nHits = extrapolator.Extrapolate( geometry->GetCalorimeterFaceR(), geometry->GetCalorimeterFaceZ(), bz, propagator->GetMaxOrbs() ) ;
+      auto markers = std::make_unique<ROOT::REvePointSet>( "Calorimeter entry points (" + std::to_string( nHits ) + ")", "", nHits ) ;
+      markers->SetMainColor( kTeal ) ;
+      markers->SetMarkerColor( kTeal ) ;
+      markers->SetMarkerSize( GetParameter<int>( "CaloFaceMarkerSize" ).value_or( 4 ) ) ;
+      markers->SetMarkerStyle( GetParameter<int>( "CaloFaceMarkerStyle" ).value_or( kFullCircle ) ) ;
+      markers->SetPickable( false ) ;
+      for( std::size_t i=0 ; i<extrapolator.GetSize() ; ++i ) {
+        if( extrapolator.HasIntersection( i ) ) {
+          auto point = extrapolator.GetIntersection( i ) ;
+          markers->SetNextPoint( point.fX, point.fY, point.fZ ) ;
+        }
+      }
+      // A sibling of the track list in the collection scene: the track list only holds tracks
+      auto eventConverter = this->GetEventDisplay()->GetEventConverter() ;
+      auto trackList = eveTrackList.release() ;
+      eventConverter->StreamElement( trackList ) ;
+      eventConverter->StreamElement( markers.release() ) ;
+      return trackList ;
+    }
     return eveTrackList.release() ;
   }
   
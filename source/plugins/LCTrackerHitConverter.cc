@@ -0,0 +1,323 @@
+// -- lceve headers
+#include <LCEve/ICollectionConverter.h>
+#include <LCEve/EveElementFactory.h>
+#include <LCEve/LCIOHelper.h>
+#include <LCEve/DrawAttributes.h>
+#include <LCEve/Geometry.h>
+#include <LCEve/MemoryMonitor.h>
+#include <LCEve/EventArena.h>
+#include <LCEve/EventConverter.h>
+#include <LCEve/ObjectRegistry.h>
+#include <LCEve/Factories.h>
+
+// -- lcio headers
+#include <EVENT/LCCollection.h>
+#include <EVENT/LCIO.h>
+#include <EVENT/TrackerHit.h>
+#include <EVENT/TrackerHitPlane.h>
+#include <EVENT/SimTrackerHit.h>
+#include <UTIL/LCIOTypeInfo.h>
+#include <UTIL/BitField64.h>
+#include <UTIL/BitSet32.h>
+#include <UTIL/ILDConf.h>
+
+// -- dd4hep headers
+#include <DD4hep/Detector.h>
+
+// -- root headers
+#include <ROOT/REvePointSet.hxx>
+#include <ROOT/REveStraightLineSet.hxx>
+
+// -- std headers
+#include <map>
+#include <cmath>
+#include <cstdint>
+
+namespace lceve {
+
+  /// A decoded field of a cell id: extracted with a mask and a shift,
+  /// without the string lookup of BitField64 for each hit
+  struct CellIDField {
+    std::uint64_t      fMask {0} ;
+    unsigned int       fOffset {0} ;
+    unsigned int       fWidth {0} ;
+    bool               fSigned {false} ;
+
+    /// Decode the field value
+    inline long Decode( std::uint64_t cellID ) const {
+      auto value = static_cast<long>( (cellID & fMask) >> fOffset ) ;
+      if( fSigned and (value & (1L << (fWidth - 1))) ) {
+        value -= (1L << fWidth) ;
+      }
+      return value ;
+    }
+  };
+
+  //--------------------------------------------------------------------------
+
+  /// Get the strip direction of a one dimensional hit. Only planar hits can be strips
+  template <typename T>
+  inline bool StripDirection( const T *const /*hit*/, ROOT::REveVector &/*direction*/ ) {
+    return false ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <>
+  inline bool StripDirection( const EVENT::TrackerHitPlane *const hit, ROOT::REveVector &direction ) {
+    if( not UTIL::BitSet32( hit->getType() )[ UTIL::ILDTrkHitTypeBit::ONE_DIMENSIONAL ] ) {
+      return false ;
+    }
+    // the strip runs along v, given as (theta, phi)
+    auto v = hit->getV() ;
+    direction.Set( std::sin( v[0] ) * std::cos( v[1] ), std::sin( v[0] ) * std::sin( v[1] ), std::cos( v[0] ) ) ;
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /**
+   *  @brief  LCTrkHitConverter class
+   *  Converts tracker hit collections (TrackerHit, TrackerHitPlane, SimTrackerHit)
+   *  to point sets, one per subdetector layer decoded from the cell id.
+   *  Strip hits (one dimensional planar hits) are drawn as line segments.
+   *  Points are filled in bulk: the only per-hit storage is the group index,
+   *  allocated in the event arena. The hits are indexed in the object registry
+   *  with their point (or line) index, for the highlighting of related objects,
+   *  with one registry call per point set.
+   *
+   *  Parameters:
+   *  - Color: the hit color. With 'iter', one color per group (default)
+   *  - MarkerSize, MarkerStyle: the hit marker attributes (default 2 and 4 or 5 for sim hits)
+   *  - GroupBy: 'layer' (default), 'system' or 'none'
+   *  - CellIDEncoding: the cell id encoding, if not in the collection parameters
+   *  - SystemField, LayerField: the cell id field names (default 'system' and 'layer')
+   *  - StripLength: the length of the strip segments, in cm (default 10)
+   */
+  template <typename T>
+  class LCTrkHitConverter : public ICollectionConverter {
+  public:
+    /// Default constructor
+    LCTrkHitConverter() = default ;
+
+    ///  Create point sets out of tracker hit objects
+    ROOT::REveElement* ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) override ;
+
+  private:
+    /// A group of hits (subdetector layer)
+    struct HitGroup {
+      long                          fSystem {0} ;
+      long                          fLayer {0} ;
+      unsigned int                  fNPoints {0} ;
+      unsigned int                  fNStrips {0} ;
+      /// The offset of the group hits in the flat hit array: points then strips
+      std::size_t                   fOffset {0} ;
+      TrackerHitContainer          *fPoints {nullptr} ;
+      ROOT::REveStraightLineSet    *fStrips {nullptr} ;
+    };
+
+    /// Get the default marker style
+    int GetDefaultMarkerStyle() const ;
+    /// Get the subdetector name from its system id
+    std::string GetSystemName( long system ) const ;
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  template <typename T>
+  ROOT::REveElement* LCTrkHitConverter<T>::ProcessCollection( const std::string &name, const EVENT::LCCollection *const collection ) {
+    std::string typeName = UTIL::lctypename<T>() ;
+    if( collection->getTypeName() != typeName ) {
+      std::cout << "ERROR: Expected collection type " << typeName << " , got " << collection->getTypeName() << std::endl ;
+      return nullptr ;
+    }
+    const std::size_t nHits = collection->getNumberOfElements() ;
+
+    // Cell id fields used for grouping
+    auto groupBy = GetParameter<std::string>( "GroupBy" ).value_or( "layer" ) ;
+    auto encoding = collection->getParameters().getStringVal( EVENT::LCIO::CellIDEncoding ) ;
+    encoding = GetParameter<std::string>( "CellIDEncoding" ).value_or( encoding ) ;
+    CellIDField systemField {}, layerField {} ;
+    if( groupBy != "none" ) {
+      if( encoding.empty() ) {
+        std::cout << "WARNING: No cell id encoding for collection " << name << ", hits are not grouped" << std::endl ;
+      }
+      else {
+        try {
+          UTIL::BitField64 decoder( encoding ) ;
+          auto fillField = [&]( const std::string &fieldName, CellIDField &field ) {
+            auto &value = decoder[ fieldName ] ;
+            field.fMask = value.mask() ;
+            field.fOffset = value.offset() ;
+            field.fWidth = value.width() ;
+            field.fSigned = value.isSigned() ;
+          } ;
+          fillField( GetParameter<std::string>( "SystemField" ).value_or( "system" ), systemField ) ;
+          if( groupBy == "layer" ) {
+            fillField( GetParameter<std::string>( "LayerField" ).value_or( "layer" ), layerField ) ;
+          }
+        }
+        catch( std::exception &e ) {
+          std::cout << "WARNING: Couldn't decode cell ids of collection " << name << ": " << e.what() << ", hits are not grouped" << std::endl ;
+          systemField = CellIDField {} ;
+          layerField = CellIDField {} ;
+        }
+      }
+    }
+
+    // Level of detail: keep one hit out of 'stride' if the memory budget is exceeded
+    std::size_t stride = 1 ;
+    if( (GetEventDisplay()->GetMemoryMonitor().GetDegradation() >= MemoryMonitor::Degradation::LevelOfDetail) and
+        (nHits > MemoryMonitor::fgLODMaxPoints) ) {
+      stride = (nHits + MemoryMonitor::fgLODMaxPoints - 1) / MemoryMonitor::fgLODMaxPoints ;
+    }
+
+    // First pass: group index of each hit and group sizes
+    auto converter = GetEventDisplay()->GetEventConverter() ;
+    auto resource = (nullptr == converter) ? std::pmr::new_delete_resource() : converter->GetMemoryResource() ;
+    std::map<std::pair<long, long>, std::uint32_t> groupIndices {} ;
+    std::vector<HitGroup> groups {} ;
+    ArenaVector<std::uint32_t> hitGroups( resource ) ;
+    ArenaVector<char> hitStrips( resource ) ;
+    hitGroups.reserve( nHits / stride + 1 ) ;
+    hitStrips.reserve( nHits / stride + 1 ) ;
+    ROOT::REveVector direction {} ;
+    for( std::size_t h=0 ; h<nHits ; h+=stride ) {
+      auto hit = static_cast<const T*>( collection->getElementAt( h ) ) ;
+      auto cellID = LCIOHelper::GetCellID( hit ) ;
+      auto key = std::make_pair( systemField.Decode( cellID ), layerField.Decode( cellID ) ) ;
+      auto iter = groupIndices.find( key ) ;
+      if( groupIndices.end() == iter ) {
+        iter = groupIndices.insert( { key, static_cast<std::uint32_t>( groups.size() ) } ).first ;
+        HitGroup group {} ;
+        group.fSystem = key.first ;
+        group.fLayer = key.second ;
+        groups.push_back( group ) ;
+      }
+      const bool strip = StripDirection( hit, direction ) ;
+      strip ? ++groups[ iter->second ].fNStrips : ++groups[ iter->second ].fNPoints ;
+      hitGroups.push_back( iter->second ) ;
+      hitStrips.push_back( strip ) ;
+    }
+
+    // Create the group elements, sorted by system and layer
+    auto color = GetParameter<std::string>( "Color" ).value_or( "iter" ) ;
+    auto colorFunctor = ColorHelper::GetColorFunction( color ) ;
+    const auto markerSize = GetParameter<int>( "MarkerSize" ).value_or( 2 ) ;
+    const auto markerStyle = GetParameter<int>( "MarkerStyle" ).value_or( GetDefaultMarkerStyle() ) ;
+    const float stripLength = GetParameter<float>( "StripLength" ).value_or( 10.f ) ;
+    const bool grouped = (groups.size() > 1) or (0 != systemField.fMask) ;
+
+    EveElementFactory eveFactory( this->GetEventDisplay() ) ;
+    auto eveHitList = std::make_unique<ROOT::REveElement>() ;
+    eveHitList->SetName( name ) ;
+    eveHitList->SetMainColor( kPink ) ;
+    for( auto &index : groupIndices ) {
+      auto &group = groups[ index.second ] ;
+      std::string groupName = name ;
+      if( grouped ) {
+        groupName = GetSystemName( group.fSystem ) ;
+        if( 0 != layerField.fMask ) {
+          groupName += " layer " + std::to_string( group.fLayer ) ;
+        }
+      }
+      const auto groupColor = colorFunctor() ;
+      if( group.fNPoints > 0 ) {
+        auto points = eveFactory.CreateTrackerHitContainer() ;
+        points->Reset( group.fNPoints ) ;
+        points->SetName( groupName + " (" + std::to_string( group.fNPoints ) + ")" ) ;
+        points->SetMainColor( groupColor ) ;
+        points->SetMarkerColor( groupColor ) ;
+        points->SetMarkerSize( markerSize ) ;
+        points->SetMarkerStyle( markerStyle ) ;
+        group.fPoints = points.get() ;
+        eveHitList->AddElement( points.release() ) ;
+      }
+      if( group.fNStrips > 0 ) {
+        auto strips = std::make_unique<ROOT::REveStraightLineSet>() ;
+        strips->SetName( groupName + " strips (" + std::to_string( group.fNStrips ) + ")" ) ;
+        strips->SetMainColor( groupColor ) ;
+        strips->SetLineColor( groupColor ) ;
+        group.fStrips = strips.get() ;
+        eveHitList->AddElement( strips.release() ) ;
+      }
+    }
+
+    // Second pass: fill the points and strips.
+    // The hits of each point set are collected in a flat array and indexed at once
+    auto registry = (nullptr == converter) ? nullptr : &converter->GetObjectRegistry() ;
+    ArenaVector<const void*> hitObjects( resource ) ;
+    if( nullptr != registry ) {
+      std::size_t offset = 0 ;
+      for( auto &group : groups ) {
+        group.fOffset = offset ;
+        offset += group.fNPoints + group.fNStrips ;
+      }
+      hitObjects.resize( offset, nullptr ) ;
+    }
+    for( std::size_t h=0, i=0 ; h<nHits ; h+=stride, ++i ) {
+      auto hit = static_cast<const T*>( collection->getElementAt( h ) ) ;
+      auto &group = groups[ hitGroups[i] ] ;
+      auto pos = hit->getPosition() ;
+      const ROOT::REveVector position( pos[0]*0.1, pos[1]*0.1, pos[2]*0.1 ) ;
+      if( hitStrips[i] ) {
+        StripDirection( hit, direction ) ;
+        direction *= 0.5f * stripLength ;
+        auto line = group.fStrips->AddLine( position - direction, position + direction ) ;
+        if( nullptr != registry ) {
+          hitObjects[ group.fOffset + group.fNPoints + line->fId ] = hit ;
+        }
+      }
+      else {
+        if( nullptr != registry ) {
+          hitObjects[ group.fOffset + group.fPoints->GetSize() ] = hit ;
+        }
+        group.fPoints->SetNextPoint( position.fX, position.fY, position.fZ ) ;
+      }
+    }
+    if( nullptr != registry ) {
+      for( auto &group : groups ) {
+        if( nullptr != group.fPoints ) {
+          registry->IndexRange( group.fPoints, hitObjects.data() + group.fOffset, group.fNPoints ) ;
+        }
+        if( nullptr != group.fStrips ) {
+          registry->IndexRange( group.fStrips, hitObjects.data() + group.fOffset + group.fNPoints, group.fNStrips ) ;
+        }
+      }
+    }
+    return eveHitList.release() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename T>
+  int LCTrkHitConverter<T>::GetDefaultMarkerStyle() const {
+    return (UTIL::lctypename<T>() == EVENT::LCIO::SIMTRACKERHIT) ? 5 : 4 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  template <typename T>
+  std::string LCTrkHitConverter<T>::GetSystemName( long system ) const {
+    for( auto &detector : GetEventDisplay()->GetGeometry()->GetDetector().detectors() ) {
+      if( dd4hep::DetElement( detector.second ).id() == system ) {
+        return detector.first ;
+      }
+    }
+    return "System " + std::to_string( system ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  using LCTrackerHitConverter = LCTrkHitConverter<EVENT::TrackerHit> ;
+  using LCTrackerHitPlaneConverter = LCTrkHitConverter<EVENT::TrackerHitPlane> ;
+  using LCSimTrackerHitConverter = LCTrkHitConverter<EVENT::SimTrackerHit> ;
+}
+
+using namespace lceve ;
+// Declare converter plugin
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCTrackerHitConverter)
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCTrackerHitPlaneConverter)
+LCEVE_DECLARE_CONVERTER_NS(lceve, LCSimTrackerHitConverter)
@@ -6,6 +6,7 @@
 #include <LCEve/DrawAttributes.h>
 #include <LCEve/Geometry.h>
 #include <LCEve/Factories.h>
+#include <LCEve/EigenHelper.h>
 
 // -- lcio headers
 #include <EVENT/LCCollection.h>
@@ -82,11 +83,31 @@ namespace lceve {
     eveVertexList->SetName( name ) ;
     eveVertexList->SetMainColor( kPink ) ;
 
+    // Convert all vertices first to decompose the error matrices in one batch
+    auto resource = lcFactory.GetMemoryResource() ;
+    ArenaVector<VertexParameters> parametersList ( resource ) ;
+    ArenaVector<EigenHelper::SymMatrix3_t> errors ( resource ) ;
+    ArenaVector<std::size_t> errorIndices ( resource ) ;
+    parametersList.reserve( vertexs.size() ) ;
+    errors.reserve( vertexs.size() ) ;
+    errorIndices.reserve( vertexs.size() ) ;
     for( auto lcVertex : vertexs ) {
       auto params = lcFactory.ConvertVertex( lcVertex ) ;
       auto attr = params.fLineAttributes.value_or( LineAttributes {} ) ;
       attr.fColor = colorFunctor() ;
       params.fLineAttributes = attr ;
+      if( params.fErrors ) {
+        errors.push_back( params.fErrors.value() ) ;
+        errorIndices.push_back( parametersList.size() ) ;
+      }
+      parametersList.push_back( std::move( params ) ) ;
+    }
+    ArenaVector<EigenHelper::Eigen3> eigens( errors.size(), resource ) ;
+    EigenHelper::DecomposeBatch( errors.data(), errors.size(), eigens.data() ) ;
+    for( std::size_t i=0 ; i<errorIndices.size() ; ++i ) {
+      parametersList[ errorIndices[i] ].fAxes = EigenHelper::EllipsoidAxes( eigens[i], EveElementFactory::VertexExtentFactor ) ;
+    }
+    for( auto &params : parametersList ) {
       auto eveVertex = eveFactory.CreateVertex( params ) ;
       eveVertexList->AddElement( eveVertex ) ;
     }
@@ -0,0 +1,83 @@
+// -- lceve headers
+#include <LCEve/CellIDPositionCache.h>
+
+// -- dd4hep headers
+#include <DD4hep/Detector.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DDRec/CellIDPositionConverter.h>
+
+// -- std headers
+#include <cmath>
+#include <limits>
+
+namespace lceve {
+
+  CellIDPositionCache::CellIDPositionCache( const dd4hep::Detector &detector ) :
+    fConverter( std::make_unique<dd4hep::rec::CellIDPositionConverter>( detector ) ) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  CellIDPositionCache::~CellIDPositionCache() = default ;
+
+  //--------------------------------------------------------------------------
+
+  std::optional<CellIDPositionCache::Position_t> CellIDPositionCache::GetPosition( std::uint64_t cellID ) {
+    auto iter = fPositions.find( cellID ) ;
+    if( fPositions.end() != iter ) {
+      ++fHits ;
+    }
+    else {
+      ++fMisses ;
+      Position_t position {} ;
+      if( nullptr == fConverter->findContext( cellID ) ) {
+        const auto nan = std::numeric_limits<float>::quiet_NaN() ;
+        position.Set( nan, nan, nan ) ;
+      }
+      else {
+        auto global = fConverter->position( cellID ) ;
+        position.Set( global.x() / dd4hep::cm, global.y() / dd4hep::cm, global.z() / dd4hep::cm ) ;
+      }
+      iter = fPositions.emplace( cellID, position ).first ;
+    }
+    if( std::isnan( iter->second.fX ) ) {
+      return std::nullopt ;
+    }
+    return iter->second ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CellIDPositionCache::GetSize() const {
+    return fPositions.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CellIDPositionCache::GetBytes() const {
+    // node (key, value, next pointer, hash) plus bucket pointer
+    return fPositions.size() * (sizeof(std::uint64_t) + sizeof(Position_t) + 2*sizeof(void*)) +
+      fPositions.bucket_count() * sizeof(void*) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CellIDPositionCache::GetHits() const {
+    return fHits ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CellIDPositionCache::GetMisses() const {
+    return fMisses ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CellIDPositionCache::Clear() {
+    fPositions.clear() ;
+    fPositions.rehash( 0 ) ;
+  }
+
+}
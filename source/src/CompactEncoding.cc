@@ -0,0 +1,154 @@
+// -- lceve headers
+#include <LCEve/CompactEncoding.h>
+
+// -- std headers
+#include <cmath>
+#include <cstring>
+
+namespace lceve {
+
+  bool CompactEncoding::fgEnabled = false ;
+  float CompactEncoding::fgResolution = 0.f ;
+  std::array<float,3> CompactEncoding::fgOrigin = { 0.f, 0.f, 0.f } ;
+  std::size_t CompactEncoding::fgEncodedBytes = 0 ;
+  std::size_t CompactEncoding::fgRawBytes = 0 ;
+
+  //--------------------------------------------------------------------------
+
+  void CompactEncoding::Enable( float resolution, const std::array<float,3> &origin ) {
+    fgEnabled = ( resolution > 0.f ) ;
+    fgResolution = resolution ;
+    fgOrigin = origin ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompactEncoding::IsEnabled() {
+    return fgEnabled ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  float CompactEncoding::GetResolution() {
+    return fgResolution ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompactEncoding::Encode( const float *points, std::size_t n, std::vector<std::uint32_t> &words ) {
+    Encode( points, n, fgResolution, fgOrigin, words ) ;
+    fgEncodedBytes += words.size() * sizeof(std::uint32_t) ;
+    fgRawBytes += 3 * n * sizeof(float) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompactEncoding::Encode( const float *points, std::size_t n, float resolution, const std::array<float,3> &origin, std::vector<std::uint32_t> &words ) {
+    auto floatBits = []( float value ) {
+      std::uint32_t bits ;
+      std::memcpy( &bits, &value, sizeof(bits) ) ;
+      return bits ;
+    } ;
+    words.clear() ;
+    // most deltas of consecutive hits fit in 2 bytes
+    words.reserve( fgHeaderWords + ( 6 * n + 3 ) / 4 ) ;
+    words.push_back( fgMagic ) ;
+    words.push_back( static_cast<std::uint32_t>( n ) ) ;
+    words.push_back( floatBits( resolution ) ) ;
+    for( auto value : origin ) {
+      words.push_back( floatBits( value ) ) ;
+    }
+    words.push_back( 0 ) ;
+    const double scale = 1. / resolution ;
+    std::size_t nBytes = 0 ;
+    auto pushByte = [&]( std::uint32_t byte ) {
+      if( 0 == nBytes % 4 ) {
+        words.push_back( 0 ) ;
+      }
+      words.back() |= byte << ( 8 * ( nBytes % 4 ) ) ;
+      ++nBytes ;
+    } ;
+    std::int64_t previous[3] = { 0, 0, 0 } ;
+    for( std::size_t i=0 ; i<n ; ++i ) {
+      for( std::size_t axis=0 ; axis<3 ; ++axis ) {
+        // in double: far from the origin, the float difference is coarser than a fine grid
+        const auto quantised = static_cast<std::int64_t>( std::llround( ( static_cast<double>( points[3*i+axis] ) - origin[axis] ) * scale ) ) ;
+        const std::int64_t delta = quantised - previous[axis] ;
+        previous[axis] = quantised ;
+        // zigzag: small negative and positive deltas both map to small values
+        auto value = ( static_cast<std::uint64_t>( delta ) << 1 ) ^ static_cast<std::uint64_t>( delta >> 63 ) ;
+        while( value >= 0x80 ) {
+          pushByte( static_cast<std::uint32_t>( value & 0x7f ) | 0x80 ) ;
+          value >>= 7 ;
+        }
+        pushByte( static_cast<std::uint32_t>( value ) ) ;
+      }
+    }
+    words[6] = static_cast<std::uint32_t>( nBytes ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompactEncoding::Decode( const std::vector<std::uint32_t> &words, std::vector<float> &points ) {
+    points.clear() ;
+    if( ( words.size() < fgHeaderWords ) or ( fgMagic != words[0] ) ) {
+      return false ;
+    }
+    auto bitsFloat = []( std::uint32_t bits ) {
+      float value ;
+      std::memcpy( &value, &bits, sizeof(value) ) ;
+      return value ;
+    } ;
+    const std::size_t n = words[1] ;
+    const float resolution = bitsFloat( words[2] ) ;
+    const float origin[3] = { bitsFloat( words[3] ), bitsFloat( words[4] ), bitsFloat( words[5] ) } ;
+    const std::size_t nBytes = words[6] ;
+    if( ( words.size() - fgHeaderWords ) * 4 < nBytes ) {
+      return false ;
+    }
+    points.reserve( 3 * n ) ;
+    std::size_t byte = 0 ;
+    std::int64_t current[3] = { 0, 0, 0 } ;
+    for( std::size_t i=0 ; i<3*n ; ++i ) {
+      std::uint64_t value = 0 ;
+      unsigned int shift = 0 ;
+      while( true ) {
+        if( ( byte >= nBytes ) or ( shift > 63 ) ) {
+          return false ;
+        }
+        const std::uint64_t b = ( words[ fgHeaderWords + byte / 4 ] >> ( 8 * ( byte % 4 ) ) ) & 0xff ;
+        ++byte ;
+        value |= ( b & 0x7f ) << shift ;
+        shift += 7 ;
+        if( 0 == ( b & 0x80 ) ) {
+          break ;
+        }
+      }
+      const auto delta = static_cast<std::int64_t>( value >> 1 ) ^ -static_cast<std::int64_t>( value & 1 ) ;
+      current[i%3] += delta ;
+      // in double: a float index is not exact beyond 2^24 grid steps
+      points.push_back( static_cast<float>( origin[i%3] + static_cast<double>( resolution ) * current[i%3] ) ) ;
+    }
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CompactEncoding::GetEncodedBytes() {
+    return fgEncodedBytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CompactEncoding::GetRawBytes() {
+    return fgRawBytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompactEncoding::ResetCounters() {
+    fgEncodedBytes = 0 ;
+    fgRawBytes = 0 ;
+  }
+
+}
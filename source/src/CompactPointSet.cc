@@ -0,0 +1,31 @@
+// -- lceve headers
+#include <LCEve/CompactPointSet.h>
+#include <LCEve/CompactEncoding.h>
+
+// -- root headers
+#include <ROOT/REveRenderData.hxx>
+
+// -- std headers
+#include <vector>
+#include <cstdint>
+
+namespace lceve {
+
+  void CompactPointSet::BuildRenderData() {
+    if( (not CompactEncoding::IsEnabled()) or (fSize <= 0) ) {
+      ROOT::REvePointSet::BuildRenderData() ;
+      return ;
+    }
+    std::vector<std::uint32_t> words {} ;
+    CompactEncoding::Encode( &fPoints[0].fX, fSize, words ) ;
+    if( words.size() >= 3 * static_cast<std::size_t>( fSize ) ) {
+      // a few points only: the header doesn't pay off
+      ROOT::REvePointSet::BuildRenderData() ;
+      return ;
+    }
+    fRenderData = std::make_unique<ROOT::REveRenderData>( "makeCompactHit", words.size() ) ;
+    // the words are copied bit for bit in the float vertex buffer
+    fRenderData->PushV( reinterpret_cast<float*>( words.data() ), words.size() ) ;
+  }
+
+}
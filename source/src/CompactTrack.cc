@@ -0,0 +1,35 @@
+// -- lceve headers
+#include <LCEve/CompactTrack.h>
+#include <LCEve/CompactEncoding.h>
+
+// -- root headers
+#include <ROOT/REveRenderData.hxx>
+
+// -- std headers
+#include <vector>
+#include <cstdint>
+
+namespace lceve {
+
+  void CompactTrack::BuildRenderData() {
+    if( (not CompactEncoding::IsEnabled()) or (fSize <= 0) ) {
+      ROOT::REveTrack::BuildRenderData() ;
+      return ;
+    }
+    std::vector<std::uint32_t> words {} ;
+    CompactEncoding::Encode( &fPoints[0].fX, fSize, words ) ;
+    if( words.size() >= 3 * static_cast<std::size_t>( fSize ) ) {
+      // a few points only: the header doesn't pay off
+      ROOT::REveTrack::BuildRenderData() ;
+      return ;
+    }
+    fRenderData = std::make_unique<ROOT::REveRenderData>( "makeCompactTrack", words.size(), 0, fBreakPoints.size() ) ;
+    // the words are copied bit for bit in the float vertex buffer
+    fRenderData->PushV( reinterpret_cast<float*>( words.data() ), words.size() ) ;
+    // same index buffer as REveTrack: the line break points
+    if( not fBreakPoints.empty() ) {
+      fRenderData->PushI( fBreakPoints ) ;
+    }
+  }
+
+}
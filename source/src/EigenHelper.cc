@@ -0,0 +1,80 @@
+// -- lceve headers
+#include <LCEve/EigenHelper.h>
+
+// -- std headers
+#include <cmath>
+#include <algorithm>
+
+namespace lceve {
+
+  EigenHelper::Eigen3 EigenHelper::Decompose( const SymMatrix3_t &matrix ) {
+    Eigen3 result {} ;
+    DecomposeBatch( &matrix, 1, &result ) ;
+    return result ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EigenHelper::DecomposeBatch( const SymMatrix3_t *matrices, std::size_t n, Eigen3 *results ) {
+    static constexpr int pairs[3][2] = { {0, 1}, {0, 2}, {1, 2} } ;
+    for( std::size_t m=0 ; m<n ; ++m ) {
+      const auto &lower = matrices[m] ;
+      double a[3][3] = {
+        { lower[0], lower[1], lower[3] },
+        { lower[1], lower[2], lower[4] },
+        { lower[3], lower[4], lower[5] }
+      } ;
+      double v[3][3] = { {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.} } ;
+      const double scale = std::fabs( a[0][0] ) + std::fabs( a[1][1] ) + std::fabs( a[2][2] ) ;
+      for( unsigned int sweep=0 ; sweep<fgMaxSweeps ; ++sweep ) {
+        const double offDiagonal = std::fabs( a[0][1] ) + std::fabs( a[0][2] ) + std::fabs( a[1][2] ) ;
+        if( offDiagonal <= 1e-15 * scale ) {
+          break ;
+        }
+        for( auto &pair : pairs ) {
+          const int p = pair[0], q = pair[1], r = 3 - p - q ;
+          const double apq = a[p][q] ;
+          if( 0. == apq ) {
+            continue ;
+          }
+          // rotation annihilating a[p][q]
+          const double theta = ( a[q][q] - a[p][p] ) / ( 2. * apq ) ;
+          const double t = std::copysign( 1., theta ) / ( std::fabs( theta ) + std::sqrt( theta*theta + 1. ) ) ;
+          const double c = 1. / std::sqrt( t*t + 1. ) ;
+          const double s = t * c ;
+          a[p][p] -= t * apq ;
+          a[q][q] += t * apq ;
+          a[p][q] = a[q][p] = 0. ;
+          const double arp = a[r][p], arq = a[r][q] ;
+          a[r][p] = a[p][r] = c * arp - s * arq ;
+          a[r][q] = a[q][r] = s * arp + c * arq ;
+          for( int k=0 ; k<3 ; ++k ) {
+            const double vkp = v[k][p], vkq = v[k][q] ;
+            v[k][p] = c * vkp - s * vkq ;
+            v[k][q] = s * vkp + c * vkq ;
+          }
+        }
+      }
+      auto &result = results[m] ;
+      for( int i=0 ; i<3 ; ++i ) {
+        result.fValues[i] = a[i][i] ;
+        for( int j=0 ; j<3 ; ++j ) {
+          result.fVectors[3*i + j] = v[i][j] ;
+        }
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::array<ROOT::REveVectorT<float>,3> EigenHelper::EllipsoidAxes( const Eigen3 &eigen, float scale ) {
+    std::array<ROOT::REveVectorT<float>,3> axes {} ;
+    for( int i=0 ; i<3 ; ++i ) {
+      // rounding may produce tiny negative values
+      const double length = std::sqrt( std::max( 0., eigen.fValues[i] ) ) * scale ;
+      axes[i].Set( eigen.fVectors[i] * length, eigen.fVectors[3 + i] * length, eigen.fVectors[6 + i] * length ) ;
+    }
+    return axes ;
+  }
+
+}
@@ -3,24 +3,55 @@
 #include <LCEve/DrawAttributes.h>
 #include <LCEve/EventDisplay.h>
 #include <LCEve/Geometry.h>
+#include <LCEve/Tracer.h>
+#include <LCEve/MemoryMonitor.h>
+#include <LCEve/HelixClass.h>
+#include <LCEve/EigenHelper.h>
+#include <LCEve/EventConverter.h>
+#include <LCEve/ObjectRegistry.h>
 
 // -- ROOT headers
 #include <ROOT/REveVector.hxx>
 #include <ROOT/REveTrack.hxx>
+#include <ROOT/REveTrackPropagator.hxx>
 #include <ROOT/REveVSDStructs.hxx>
 #include <ROOT/REveEllipsoid.hxx>
 #include <ROOT/REveCompound.hxx>
+#include <ROOT/REveJetCone.hxx>
 #include <Math/GenVector/LorentzVector.h>
-#include <TMatrixDEigen.h>
-#include <TMatrixDSym.h>
-#include <TVectorD.h>
 
 // -- std headers
 #include <sstream>
 #include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace lceve {
   
+  namespace {
+    
+    /// Distance along a direction (unit vector) from a point inside the
+    /// (maxR, maxZ) cylinder to its boundary
+    double DistanceToBoundary( const ROOT::REveVectorD &start, const ROOT::REveVectorD &direction, double maxR, double maxZ ) {
+      double length = std::numeric_limits<double>::max() ;
+      if( std::fabs( direction.fZ ) > 0. ) {
+        length = ( std::copysign( maxZ, direction.fZ ) - start.fZ ) / direction.fZ ;
+      }
+      const double dt2 = direction.Perp2() ;
+      if( dt2 > 0. ) {
+        const double b = start.fX*direction.fX + start.fY*direction.fY ;
+        const double c = start.Perp2() - maxR*maxR ;
+        length = std::min( length, ( -b + std::sqrt( b*b - dt2*c ) ) / dt2 ) ;
+      }
+      return std::max( 0., length ) ;
+    }
+    
+  }
+  
+  //--------------------------------------------------------------------------
+  
   EveElementFactory::EveElementFactory( EventDisplay *lced ) :
     fEventDisplay(lced) {
     /* nop */
@@ -29,6 +60,24 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   EveTrack *EveElementFactory::CreateTrack( ROOT::REveTrackPropagator *propagator, const TrackParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateTrack" ) ;
+    auto registry = this->GetObjectRegistry() ;
+    // Already created for another collection: copy its points instead of propagating again
+    if( (nullptr != registry) and parameters.fUserData ) {
+      auto registered = registry->Find<EveTrack>( parameters.fUserData.value() ) ;
+      if( nullptr != registered ) {
+        auto eveTrack = std::make_unique<EveTrack>( *registered ) ;
+        if( parameters.fLineAttributes and parameters.fLineAttributes.value().fColor ) {
+          auto color = parameters.fLineAttributes.value().fColor.value() ;
+          eveTrack->SetMainColor( color ) ;
+          eveTrack->SetLineColor( color ) ;
+        }
+        eveTrack->SetUserData( parameters.fUserData.value() ) ;
+        registry->Index( parameters.fUserData.value(), eveTrack.get() ) ;
+        registry->CountReused() ;
+        return eveTrack.release() ;
+      }
+    }
     try {
       ROOT::REveRecTrack trackInfo ;
       trackInfo.fV = parameters.fReferencePoint.value() ;
@@ -36,7 +85,12 @@ namespace lceve {
       trackInfo.fSign = parameters.fCharge.value() ;
       // Create the track
       auto eveTrack = std::make_unique<EveTrack>( &trackInfo, propagator ) ;
-      eveTrack->MakeTrack() ;
+      if( TrackRenderMode::Helix == parameters.fRenderMode.value_or( TrackRenderMode::Propagator ) ) {
+        this->MakeHelixTrack( eveTrack.get(), propagator, parameters ) ;
+      }
+      else {
+        eveTrack->MakeTrack() ;
+      }
       auto defColor = ColorHelper::RandomColor( eveTrack.get() ) ;  
       if( parameters.fMarkerAttributes ) {
         auto attr = parameters.fMarkerAttributes.value() ;
@@ -61,15 +115,17 @@ namespace lceve {
       if( parameters.fUserData ) {
         eveTrack->SetUserData( parameters.fUserData.value() ) ;
       }
-      for( auto &trackState : parameters.fTrackStates ) {
-        auto type = ROOT::REvePathMark::kReference ;
-        if( trackState.fType.value() == TrackStateType::AtEnd ) {
-          type = ROOT::REvePathMark::kDecay ;
+      if( parameters.fTrackStates ) {
+        for( auto &trackState : parameters.fTrackStates.value() ) {
+          auto type = ROOT::REvePathMark::kReference ;
+          if( trackState.fType.value() == TrackStateType::AtEnd ) {
+            type = ROOT::REvePathMark::kDecay ;
+          }
+          ROOT::REvePathMark eveMark( type ) ;
+          eveMark.fV = trackState.fReferencePoint.value() ;
+          eveMark.fP = trackState.fMomentum.value() ;
+          eveTrack->AddPathMark( eveMark );
         }
-        ROOT::REvePathMark eveMark( type ) ;
-        eveMark.fV = trackState.fReferencePoint.value() ;
-        eveMark.fP = trackState.fMomentum.value() ;
-        eveTrack->AddPathMark( eveMark );
       }
       // so here I set the name as the title to display the tooltip correctly.
       // When this is fixed we should switch back to SetName( trkName.str() ) ;
@@ -90,6 +146,9 @@ namespace lceve {
       trkTitle << "----------------------------------" << std::endl ;
       trkTitle << this->PropertiesAsString( parameters.fProperties ) << std::endl ;
       eveTrack->SetTitle( trkTitle.str() ) ;
+      if( (nullptr != registry) and parameters.fUserData ) {
+        registry->Register( parameters.fUserData.value(), eveTrack.get() ) ;
+      }
 
       return eveTrack.release() ;
     }
@@ -102,6 +161,7 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   EveVertex *EveElementFactory::CreateVertex( const VertexParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateVertex" ) ;
     try {
       auto eveVertex = std::make_unique<EveVertex>() ;
       auto position = parameters.fPosition.value() ;
@@ -120,20 +180,10 @@ namespace lceve {
       // Calculate vertex extent using vertex errors
       // The 6 parameters of a symetric matrix 
       auto errors = parameters.fErrors.value() ;
-      TMatrixDSym xxx(3) ;
-      xxx(0, 0) = errors[0] ;
-      xxx(1, 0) = errors[1] ; xxx(1, 1) = errors[2] ;
-      xxx(2, 0) = errors[3] ; xxx(2, 1) = errors[4] ; xxx(2, 2) = errors[5] ;
-      // Get eigen vectors
-      TMatrixDEigen eig(xxx);
-      TVectorD eigenValues = TVectorD( eig.GetEigenValues() ).Sqrt() ;
-      TMatrixD eigenVectors = eig.GetEigenVectors();
-      ROOT::REveVector baseVectors[3];
-      for (int i = 0; i < 3; ++i) {
-         baseVectors[i].Set(eigenVectors(0,i), eigenVectors(1,i), eigenVectors(2,i));
-         baseVectors[i] *= eigenValues(i)*EveElementFactory::VertexExtentFactor ;
-      }
-      eveVertex->SetBaseVectors( baseVectors[0], baseVectors[1], baseVectors[2] ) ;
+      // Axes may have been computed for a whole collection at once
+      auto axes = parameters.fAxes.has_value() ? parameters.fAxes.value() :
+        EigenHelper::EllipsoidAxes( EigenHelper::Decompose( errors ), EveElementFactory::VertexExtentFactor ) ;
+      eveVertex->SetBaseVectors( axes[0], axes[1], axes[2] ) ;
       eveVertex->Outline();
       
       // Vertex name
@@ -163,6 +213,23 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   EveCluster *EveElementFactory::CreateCluster( const ClusterParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateCluster" ) ;
+    auto registry = this->GetObjectRegistry() ;
+    // Already created for another collection: copy its hits instead of converting again
+    if( (nullptr != registry) and parameters.fUserData ) {
+      auto registered = registry->Find<EveCluster>( parameters.fUserData.value() ) ;
+      if( nullptr != registered ) {
+        auto eveCluster = std::make_unique<EveCluster>( *registered ) ;
+        if( parameters.fMarkerAttributes and parameters.fMarkerAttributes.value().fColor ) {
+          eveCluster->SetMarkerColor( parameters.fMarkerAttributes.value().fColor.value() ) ;
+        }
+        eveCluster->SetUserData( parameters.fUserData.value() ) ;
+        registry->Index( parameters.fUserData.value(), eveCluster.get() ) ;
+        registry->IndexCopy( registered, eveCluster.get() ) ;
+        registry->CountReused() ;
+        return eveCluster.release() ;
+      }
+    }
     try {
       auto eveCluster = std::make_unique<EveCluster>() ;
       auto defColor = ColorHelper::RandomColor( eveCluster.get() ) ;
@@ -173,8 +240,7 @@ namespace lceve {
       eveCluster->SetMarkerSize( attr.fSize.value_or( 3 ) ) ;
       eveCluster->SetMarkerStyle( attr.fStyle.value_or( 4 ) ) ;
       // fill the cluster with calo hits
-      auto caloHits = parameters.fCaloHits.value() ;
-      this->PopulateCaloHits( eveCluster.get(), caloHits ) ;
+      this->PopulateCaloHits( eveCluster.get(), parameters.fCaloHits.value() ) ;
       // generate name and title based on cluster properties
       std::stringstream clusterName ;
       clusterName << "Cluster E=" << parameters.fEnergy.value() << " GeV" ;
@@ -187,6 +253,12 @@ namespace lceve {
       clusterTitle << this->PropertiesAsString( parameters.fProperties ) ;
       eveCluster->SetName( clusterName.str() ) ;
       eveCluster->SetTitle( clusterTitle.str() ) ;
+      if( parameters.fUserData ) {
+        eveCluster->SetUserData( parameters.fUserData.value() ) ;
+        if( nullptr != registry ) {
+          registry->Register( parameters.fUserData.value(), eveCluster.get() ) ;
+        }
+      }
       // release on return
       return eveCluster.release() ;
     }
@@ -199,44 +271,60 @@ namespace lceve {
   //--------------------------------------------------------------------------
   
   EveRecoParticle *EveElementFactory::CreateRecoParticle( const RecoParticleParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateRecoParticle" ) ;
     try {
       auto eveParticle = std::make_unique<EveRecoParticle>() ;
       if( parameters.fColor.has_value() ) {
         eveParticle->SetMainColor( parameters.fColor.value() ) ;
       }
+      if( parameters.fUserData ) {
+        eveParticle->SetUserData( parameters.fUserData.value() ) ;
+        auto registry = this->GetObjectRegistry() ;
+        if( nullptr != registry ) {
+          registry->Index( parameters.fUserData.value(), eveParticle.get() ) ;
+        }
+      }
       eveParticle->OpenCompound() ;
       // Add tracks if any
       if( parameters.fTracks ) {
-        auto tracks = parameters.fTracks.value() ;
+        auto &tracks = parameters.fTracks.value() ;
         auto eveTracks = this->CreateTrackContainer() ;
         std::string trksName = Form("Tracks (%d)",(int)tracks.size()) ;
         eveTracks->SetName( trksName ) ;
-        // Create propagator and tracks
-        auto propagator = fEventDisplay->GetGeometry()->CreateTrackPropagator() ;
+        // Create tracks with the shared propagator
+        auto propagator = fEventDisplay->GetGeometry()->GetTrackPropagator() ;
         for( auto &trk : tracks ) {
-          if( parameters.fColor.has_value() ) {
-            auto attr = trk.fLineAttributes.value_or( LineAttributes() ) ;
-            attr.fColor = parameters.fColor.value() ;
-            trk.fLineAttributes = attr ;
+          if( not parameters.fColor.has_value() ) {
+            eveTracks->AddElement( this->CreateTrack( propagator, trk ) ) ;
+            continue ;
           }
-          eveTracks->AddElement( this->CreateTrack( propagator, trk ) ) ;
+          // copy only to override the color
+          auto coloredTrk = trk ;
+          auto attr = coloredTrk.fLineAttributes.value_or( LineAttributes() ) ;
+          attr.fColor = parameters.fColor.value() ;
+          coloredTrk.fLineAttributes = attr ;
+          eveTracks->AddElement( this->CreateTrack( propagator, coloredTrk ) ) ;
         }
         eveParticle->AddElement( eveTracks.release() ) ;
       }
       // Add cluster if any
       if( parameters.fClusters ) {
-        auto clusters = parameters.fClusters.value() ;
+        auto &clusters = parameters.fClusters.value() ;
         auto eveClusters = this->CreateClusterContainer() ;
         std::string clustersName = Form("Clusters (%d)",(int)clusters.size()) ;
         eveClusters->SetName( clustersName ) ;
         // Create clusters
         for( auto &cl : clusters ) {
-          if( parameters.fColor.has_value() ) {
-            auto attr = cl.fMarkerAttributes.value_or( MarkerAttributes() ) ;
-            attr.fColor = parameters.fColor.value() ;
-            cl.fMarkerAttributes = attr ;
+          if( not parameters.fColor.has_value() ) {
+            eveClusters->AddElement( this->CreateCluster( cl ) ) ;
+            continue ;
           }
-          eveClusters->AddElement( this->CreateCluster( cl ) ) ;
+          // copy only to override the color
+          auto coloredCl = cl ;
+          auto attr = coloredCl.fMarkerAttributes.value_or( MarkerAttributes() ) ;
+          attr.fColor = parameters.fColor.value() ;
+          coloredCl.fMarkerAttributes = attr ;
+          eveClusters->AddElement( this->CreateCluster( coloredCl ) ) ;
         }
         eveParticle->AddElement( eveClusters.release() ) ;
       }
@@ -275,7 +363,70 @@ namespace lceve {
   
   //--------------------------------------------------------------------------
   
+  EveJet *EveElementFactory::CreateJet( const JetParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateJet" ) ;
+    try {
+      auto eveJet = std::make_unique<EveJet>() ;
+      auto cone = parameters.fConeParameters.value() ;
+      auto geometry = fEventDisplay->GetGeometry() ;
+      eveJet->SetCylinder( geometry->GetCalorimeterFaceR(), geometry->GetCalorimeterFaceZ() ) ;
+      eveJet->AddCone( cone[0], cone[1], std::max( cone[2], EveElementFactory::JetConeMinRadius ) ) ;
+      auto color = parameters.fColor.value_or( ColorHelper::RandomColor( eveJet.get() ) ) ;
+      eveJet->SetMainColor( color ) ;
+      eveJet->SetLineColor( color ) ;
+      eveJet->SetFillColor( color ) ;
+      eveJet->SetMainTransparency( 70 ) ;
+      if( parameters.fUserData ) {
+        eveJet->SetUserData( parameters.fUserData.value() ) ;
+        auto registry = this->GetObjectRegistry() ;
+        if( nullptr != registry ) {
+          registry->Index( parameters.fUserData.value(), eveJet.get() ) ;
+        }
+      }
+      // Add constituents if any
+      if( parameters.fParticles ) {
+        for( auto &particle : parameters.fParticles.value() ) {
+          auto coloredParticle = particle ;
+          coloredParticle.fColor = color ;
+          eveJet->AddElement( this->CreateRecoParticle( coloredParticle ) ) ;
+        }
+      }
+      auto mom = parameters.fMomentum.value() ;
+      auto energy = parameters.fEnergy.value() ;
+      // Jet name
+      std::stringstream jetName ;
+      jetName << "Jet E=" << energy << " GeV" ;
+      eveJet->SetName( jetName.str() ) ;
+      // Jet title
+      float mass {0.f} ;
+      if( parameters.fMass ) {
+        mass = parameters.fMass.value() ;
+      }
+      else {
+        ROOT::Math::PxPyPzEVector lorVec( mom[0], mom[1], mom[2], energy ) ;
+        mass = lorVec.M() ;
+      }
+      std::stringstream jetTitle ;
+      jetTitle << "Energy =" << energy << " GeV" << std::endl ;
+      jetTitle << "Mass = " << mass << " GeV" << std::endl ;
+      jetTitle << "P = " << mom.Mag() << " GeV" << std::endl ;
+      jetTitle << "Eta = " << cone[0] << ", Phi = " << cone[1] << ", R = " << cone[2] << std::endl ;
+      jetTitle << "Constituents = " << parameters.fNConstituents.value_or( 0 ) << std::endl ;
+      jetTitle << "----------------------------------" << std::endl ;
+      jetTitle << this->PropertiesAsString( parameters.fProperties ) ;
+      eveJet->SetTitle( jetTitle.str() ) ;
+      return eveJet.release() ;
+    }
+    catch( std::bad_optional_access &e ) {
+      std::cout << "Couldn't create EveJet. Missing input parameter(s)" << std::endl ;
+    }
+    return nullptr ;
+  }
+
+  //--------------------------------------------------------------------------
+
   EveMCParticle *EveElementFactory::CreateMCParticle( ROOT::REveTrackPropagator *propagator, const MCParticleParameters &parameters ) const {
+    LCEVE_TRACE_SCOPE( "EveElementFactory::CreateMCParticle" ) ;
     try {
       ROOT::REveMCTrack eveMCTrack ;
       auto energy = parameters.fEnergy.value() ;
@@ -287,7 +438,19 @@ namespace lceve {
       
       // Create the MC particle track
       auto eveMCParticle = std::make_unique<EveMCParticle>( &eveMCTrack, propagator ) ;
-      eveMCParticle->MakeTrack() ;
+      if( 0 == parameters.fCharge.value() ) {
+        // Neutral: straight segment to the endpoint or to the propagator limits
+        this->MakeStraightMCParticle( eveMCParticle.get(), propagator, parameters ) ;
+      }
+      else {
+        // The decay path mark bounds the propagation
+        if( parameters.fEndpointPosition ) {
+          ROOT::REvePathMark eveMark( ROOT::REvePathMark::kDecay ) ;
+          eveMark.fV = parameters.fEndpointPosition.value() ;
+          eveMCParticle->AddPathMark( eveMark ) ;
+        }
+        eveMCParticle->MakeTrack() ;
+      }
       auto defColor = ColorHelper::RandomColor( eveMCParticle.get() ) ;  
       if( parameters.fMarkerAttributes ) {
         auto attr = parameters.fMarkerAttributes.value() ;
@@ -311,14 +474,11 @@ namespace lceve {
       eveMCParticle->SetPickable( parameters.fPickable.value_or( true ) ) ;
       if( parameters.fUserData ) {
         eveMCParticle->SetUserData( parameters.fUserData.value() ) ;
+        auto registry = this->GetObjectRegistry() ;
+        if( nullptr != registry ) {
+          registry->Index( parameters.fUserData.value(), eveMCParticle.get() ) ;
+        }
       }
-      // if available add endpoint path mark
-      if( parameters.fEndpointPosition ) {
-        ROOT::REvePathMark eveMark( ROOT::REvePathMark::kDecay ) ;
-        eveMark.fP = parameters.fEndpointPosition.value() ;
-        eveMCParticle->AddPathMark( eveMark );      
-      }
-      
       // Particle name
       std::stringstream particleName ;
       particleName << "MCParticle PDG=" << parameters.fPDG.value() << ", E=" << energy << " GeV" ;
@@ -395,12 +555,106 @@ namespace lceve {
   
   //--------------------------------------------------------------------------
   
-  void EveElementFactory::PopulateCaloHits( CaloHitContainer *container, const std::vector<CaloHitParameters> &caloHits ) const {
+  void EveElementFactory::PopulateCaloHits( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits ) const {
     // TODO: re-implement with REveBoxSet when available
-    for( auto &c : caloHits ) {
-      auto p = c.fPosition.value() ;
-      container->SetNextPoint( p[0], p[1], p[2] ) ;
+    auto indices = this->SelectCaloHits( caloHits ) ;
+    if( indices ) {
+      for( auto index : indices.value() ) {
+        auto p = caloHits[index].fPosition.value() ;
+        container->SetNextPoint( p[0], p[1], p[2] ) ;
+      }
+    }
+    else {
+      for( auto &c : caloHits ) {
+        auto p = c.fPosition.value() ;
+        container->SetNextPoint( p[0], p[1], p[2] ) ;
+      }
     }
+    this->IndexCaloHits( container, caloHits, indices ) ;
+  }
+  
+  //--------------------------------------------------------------------------
+
+  std::vector<std::unique_ptr<CaloHitContainer>> EveElementFactory::PopulateCaloHitChunks( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits, std::size_t chunkSize ) const {
+    auto selected = this->SelectCaloHits( caloHits ) ;
+    std::vector<std::size_t> indices {} ;
+    if( selected ) {
+      indices = std::move( selected.value() ) ;
+    }
+    else {
+      indices.resize( caloHits.size() ) ;
+      std::iota( indices.begin(), indices.end(), 0 ) ;
+    }
+    // the most significant hits come first
+    std::stable_sort( indices.begin(), indices.end(), [&]( std::size_t lhs, std::size_t rhs ){
+      return caloHits[lhs].fAmplitude.value_or(0.f) > caloHits[rhs].fAmplitude.value_or(0.f) ;
+    }) ;
+    if( 0 == chunkSize ) {
+      chunkSize = std::max( indices.size(), std::size_t(1) ) ;
+    }
+    const std::size_t nChunks = ( indices.size() + chunkSize - 1 ) / chunkSize ;
+    std::vector<std::unique_ptr<CaloHitContainer>> chunks {} ;
+    for( std::size_t c=0 ; c<nChunks ; ++c ) {
+      CaloHitContainer *chunk = container ;
+      if( c > 0 ) {
+        chunks.push_back( this->CreateCaloHitContainer() ) ;
+        chunk = chunks.back().get() ;
+        std::stringstream chunkName ;
+        chunkName << container->GetName() << " [" << c+1 << "/" << nChunks << "]" ;
+        chunk->SetName( chunkName.str() ) ;
+        chunk->SetMainColor( container->GetMainColor() ) ;
+        chunk->SetMarkerColor( container->GetMarkerColor() ) ;
+        chunk->SetMarkerSize( container->GetMarkerSize() ) ;
+        chunk->SetMarkerStyle( container->GetMarkerStyle() ) ;
+      }
+      std::vector<std::size_t> chunkIndices( indices.begin() + c * chunkSize, indices.begin() + std::min( (c+1) * chunkSize, indices.size() ) ) ;
+      for( auto index : chunkIndices ) {
+        auto p = caloHits[index].fPosition.value() ;
+        chunk->SetNextPoint( p[0], p[1], p[2] ) ;
+      }
+      this->IndexCaloHits( chunk, caloHits, chunkIndices ) ;
+    }
+    return chunks ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::optional<std::vector<std::size_t>> EveElementFactory::SelectCaloHits( const ArenaVector<CaloHitParameters> &caloHits ) const {
+    const bool levelOfDetail = (fEventDisplay->GetMemoryMonitor().GetDegradation() >= MemoryMonitor::Degradation::LevelOfDetail) ;
+    if( not levelOfDetail or (caloHits.size() <= MemoryMonitor::fgLODMaxPoints) ) {
+      return std::nullopt ;
+    }
+    // keep the hits with the highest amplitudes only
+    std::vector<std::size_t> indices( caloHits.size() ) ;
+    std::iota( indices.begin(), indices.end(), 0 ) ;
+    std::nth_element( indices.begin(), indices.begin() + MemoryMonitor::fgLODMaxPoints, indices.end(), [&]( std::size_t lhs, std::size_t rhs ){
+      return caloHits[lhs].fAmplitude.value_or(0.f) > caloHits[rhs].fAmplitude.value_or(0.f) ;
+    }) ;
+    indices.resize( MemoryMonitor::fgLODMaxPoints ) ;
+    return indices ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EveElementFactory::IndexCaloHits( CaloHitContainer *container, const ArenaVector<CaloHitParameters> &caloHits, const std::optional<std::vector<std::size_t>> &indices ) const {
+    auto registry = this->GetObjectRegistry() ;
+    if( nullptr == registry ) {
+      return ;
+    }
+    const std::size_t nPoints = indices ? indices.value().size() : caloHits.size() ;
+    for( std::size_t point=0 ; point<nPoints ; ++point ) {
+      auto &hit = caloHits[ indices ? indices.value()[point] : point ] ;
+      if( hit.fUserData ) {
+        registry->Index( hit.fUserData.value(), container, static_cast<int>( point ) ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  ObjectRegistry *EveElementFactory::GetObjectRegistry() const {
+    auto converter = fEventDisplay->GetEventConverter() ;
+    return (nullptr == converter) ? nullptr : &converter->GetObjectRegistry() ;
   }
   
   //--------------------------------------------------------------------------
@@ -416,4 +670,100 @@ namespace lceve {
     return ss.str() ;
   }
 
+  //--------------------------------------------------------------------------
+
+  void EveElementFactory::MakeHelixTrack( EveTrack *eveTrack, ROOT::REveTrackPropagator *propagator, const TrackParameters &parameters ) const {
+    const ROOT::REveVectorD start( parameters.fReferencePoint.value() ) ;
+    const ROOT::REveVectorD momentum( parameters.fMomentum.value() ) ;
+    const int charge = parameters.fCharge.value() ;
+    const double maxR = propagator->GetMaxR() ;
+    const double maxZ = propagator->GetMaxZ() ;
+    auto outside = [&]( const ROOT::REveVectorD &point ) {
+      return ( point.Perp() > maxR ) or ( std::fabs( point.fZ ) > maxZ ) ;
+    } ;
+    eveTrack->SetNextPoint( start.fX, start.fY, start.fZ ) ;
+    if( outside( start ) or ( momentum.Mag2() <= 0. ) ) {
+      return ;
+    }
+    // the field is assumed to be uniform along the track
+    const double bz = -fEventDisplay->GetGeometry()->GetBField()->GetFieldD( start.fX, start.fY, start.fZ )[2] ;
+    const double pt = momentum.Perp() ;
+    double radius = std::numeric_limits<double>::infinity() ;
+    HelixClass helix ;
+    if( ( 0 != charge ) and ( std::fabs( bz ) > 0. ) and ( pt > 0. ) ) {
+      // HelixClass works in mm
+      float position[3] = { 10.f*float(start.fX), 10.f*float(start.fY), 10.f*float(start.fZ) } ;
+      float mom[3] = { float(momentum.fX), float(momentum.fY), float(momentum.fZ) } ;
+      helix.Initialize_VP( position, mom, charge, bz ) ;
+      radius = 0.1 * std::fabs( helix.getRadius() ) ;
+    }
+    // Neutral or very stiff track: straight line up to the boundary
+    if( radius > 1e3 * maxR ) {
+      const auto direction = momentum * (1. / momentum.Mag()) ;
+      const auto end = start + direction * DistanceToBoundary( start, direction, maxR, maxZ ) ;
+      eveTrack->SetNextPoint( end.fX, end.fY, end.fZ ) ;
+      return ;
+    }
+    const double xc = 0.1 * helix.getXC() ;
+    const double yc = 0.1 * helix.getYC() ;
+    // clockwise rotation (seen from +z) for positive charges in a positive field
+    const double sense = ( charge * bz > 0. ) ? -1. : 1. ;
+    const double phiStart = std::atan2( start.fY - yc, start.fX - xc ) ;
+    const double dzdAlpha = radius * momentum.fZ / pt ;
+    auto pointAt = [&]( double alpha ) {
+      const double phi = phiStart + sense * alpha ;
+      return ROOT::REveVectorD( xc + radius*std::cos( phi ), yc + radius*std::sin( phi ), start.fZ + dzdAlpha*alpha ) ;
+    } ;
+    // turning angle step such that the sagitta of each segment stays below the tolerance
+    const double step = std::min( HelixMaxStep, 2. * std::acos( 1. - std::min( 1., HelixSagittaTolerance / radius ) ) ) ;
+    const double maxAlpha = 2. * M_PI * propagator->GetMaxOrbs() ;
+    const auto nSteps = static_cast<std::size_t>( std::ceil( maxAlpha / step ) ) ;
+    for( std::size_t s=1 ; s<=nSteps ; ++s ) {
+      const double alpha = std::min( s * step, maxAlpha ) ;
+      auto point = pointAt( alpha ) ;
+      if( outside( point ) ) {
+        // bisect the last step to end on the boundary
+        double inside = alpha - step, beyond = alpha ;
+        for( unsigned int i=0 ; i<20 ; ++i ) {
+          const double middle = 0.5 * ( inside + beyond ) ;
+          ( outside( pointAt( middle ) ) ? beyond : inside ) = middle ;
+        }
+        point = pointAt( inside ) ;
+        eveTrack->SetNextPoint( point.fX, point.fY, point.fZ ) ;
+        break ;
+      }
+      eveTrack->SetNextPoint( point.fX, point.fY, point.fZ ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EveElementFactory::MakeStraightMCParticle( EveMCParticle *eveMCParticle, ROOT::REveTrackPropagator *propagator, const MCParticleParameters &parameters ) const {
+    const ROOT::REveVectorD start( parameters.fVertexPosition.value() ) ;
+    const ROOT::REveVectorD momentum( parameters.fVertexMomentum.value() ) ;
+    eveMCParticle->SetNextPoint( start.fX, start.fY, start.fZ ) ;
+    const double maxR = propagator->GetMaxR() ;
+    const double maxZ = propagator->GetMaxZ() ;
+    if( ( start.Perp() > maxR ) or ( std::fabs( start.fZ ) > maxZ ) ) {
+      return ;
+    }
+    ROOT::REveVectorD direction {} ;
+    double length = std::numeric_limits<double>::max() ;
+    if( parameters.fEndpointPosition ) {
+      direction = ROOT::REveVectorD( parameters.fEndpointPosition.value() ) - start ;
+      length = direction.Mag() ;
+    }
+    else {
+      direction = momentum ;
+    }
+    const double norm = direction.Mag() ;
+    if( norm <= 0. ) {
+      return ;
+    }
+    direction *= 1. / norm ;
+    length = std::min( length, DistanceToBoundary( start, direction, maxR, maxZ ) ) ;
+    const auto end = start + direction * length ;
+    eveMCParticle->SetNextPoint( end.fX, end.fY, end.fZ ) ;
+  }
+
 }
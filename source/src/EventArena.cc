@@ -0,0 +1,105 @@
+// -- lceve headers
+#include <LCEve/EventArena.h>
+
+// -- std headers
+#include <algorithm>
+#include <cstdint>
+
+namespace lceve {
+
+  EventArena::Scope::Scope( EventArena &arena ) :
+    fArena( arena ),
+    fPrevious( arena.fInScope ) {
+    fArena.fInScope = true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  EventArena::Scope::~Scope() {
+    fArena.fInScope = fPrevious ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  EventArena::EventArena( std::size_t blockSize ) :
+    fBlockSize( std::max( blockSize, std::size_t(1024) ) ) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventArena::Reset() {
+    fCurrent = 0 ;
+    fOffset = 0 ;
+    fUsedBytes = 0 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventArena::Release() {
+    Reset() ;
+    fBlocks.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t EventArena::GetUsedBytes() const {
+    return fUsedBytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t EventArena::GetCapacity() const {
+    std::size_t capacity = 0 ;
+    for( auto &block : fBlocks ) {
+      capacity += block.fSize ;
+    }
+    return capacity ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::pmr::memory_resource *EventArena::GetResource() {
+    return fInScope ? static_cast<std::pmr::memory_resource*>( this ) : std::pmr::new_delete_resource() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void *EventArena::do_allocate( std::size_t bytes, std::size_t alignment ) {
+    // Look for room in the current and next (retained) blocks
+    while( fCurrent < fBlocks.size() ) {
+      auto &block = fBlocks[fCurrent] ;
+      auto base = reinterpret_cast<std::uintptr_t>( block.fData.get() ) ;
+      auto aligned = (base + fOffset + alignment - 1) & ~(static_cast<std::uintptr_t>( alignment ) - 1) ;
+      auto offset = static_cast<std::size_t>( aligned - base ) ;
+      if( offset + bytes <= block.fSize ) {
+        fOffset = offset + bytes ;
+        fUsedBytes += bytes ;
+        return block.fData.get() + offset ;
+      }
+      ++fCurrent ;
+      fOffset = 0 ;
+    }
+    // Allocate a new block, doubling the size of the last one
+    std::size_t size = fBlocks.empty() ? fBlockSize : 2 * fBlocks.back().fSize ;
+    size = std::max( size, bytes + alignment ) ;
+    fBlocks.push_back( Block{ std::unique_ptr<std::byte[]>( new std::byte[size] ), size } ) ;
+    fCurrent = fBlocks.size() - 1 ;
+    fOffset = 0 ;
+    return do_allocate( bytes, alignment ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventArena::do_deallocate( void */*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/ ) {
+    // monotonic: memory is given back on Reset()
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool EventArena::do_is_equal( const std::pmr::memory_resource &other ) const noexcept {
+    return this == &other ;
+  }
+
+}
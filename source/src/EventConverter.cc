@@ -3,6 +3,9 @@
 #include <LCEve/ICollectionConverter.h>
 #include <LCEve/EventDisplay.h>
 #include <LCEve/XMLHelper.h>
+#include <LCEve/Metrics.h>
+#include <LCEve/MemoryMonitor.h>
+#include <LCEve/Tracer.h>
 
 // -- lcio headers
 #include <EVENT/LCEvent.h>
@@ -13,6 +16,14 @@
 
 // -- root headers
 #include <ROOT/REveScene.hxx>
+#include <ROOT/REveViewer.hxx>
+#include <ROOT/REveManager.hxx>
+
+// -- std headers
+#include <vector>
+#include <tuple>
+#include <chrono>
+#include <algorithm>
 
 namespace lceve {
   
@@ -23,8 +34,19 @@ namespace lceve {
   
   //--------------------------------------------------------------------------
   
+  EventConverter::~EventConverter() {
+    fEventDisplay->GetMemoryMonitor().UnregisterCache( "event arena" ) ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
   void EventConverter::Init( const TiXmlElement *element ) {
     
+    // The arena blocks are kept from one event to the next. Give them back under memory pressure
+    fEventDisplay->GetMemoryMonitor().RegisterCache( "event arena",
+      [this](){ return fArena.GetCapacity() ; },
+      [this](){ fArena.Release() ; } ) ;
+    
     CollectionConfigList_t colsConfig {} ;
     XMLHelper::ReadCollectionsConfig( element, colsConfig ) ;
     
@@ -38,28 +60,160 @@ namespace lceve {
       std::shared_ptr<ICollectionConverter> converterPtr( converter ) ;
       fConverters.insert( {c.fName, std::move(converterPtr)} ) ;       
     }
-     
+    
+    // One scene per collection, so that each collection is sent on its own
+    auto manager = fEventDisplay->GetEveManager() ;
+    for( auto &cvt : fConverters ) {
+      auto scene = manager->SpawnNewScene( cvt.first.c_str(), ("Collection " + cvt.first).c_str() ) ;
+      manager->GetDefaultViewer()->AddScene( scene ) ;
+      fScenes[ cvt.first ] = scene ;
+    }
   }
   
   //--------------------------------------------------------------------------
   
-  void EventConverter::VisualizeEvent( const EVENT::LCEvent *const event, ROOT::REveScene *eventScene ) {
+  void EventConverter::VisualizeEvent( const EVENT::LCEvent *const event ) {
+    LCEVE_TRACE_SCOPE( "EventConverter::VisualizeEvent" ) ;
+    const auto eventStart = std::chrono::steady_clock::now() ;
+    auto &metrics = fEventDisplay->GetMetrics() ;
+    const bool skipLazy = (fEventDisplay->GetMemoryMonitor().GetDegradation() >= MemoryMonitor::Degradation::SkipLazy) ;
+    // The conversion temporaries of the previous event are gone: rewind the arena
+    fArena.Reset() ;
+    EventArena::Scope arenaScope( fArena ) ;
+    // Objects shared by several collections are converted once
+    ObjectRegistry::Scope registryScope( fObjectRegistry ) ;
+    for( auto &relations : fRelationIndices ) {
+      relations.second.Clear() ;
+    }
+    // Collect the available collections, sorted by priority then by name
+    std::vector<std::tuple<int, const std::string*, ICollectionConverter*, EVENT::LCCollection*>> collections {} ;
     for( auto &cvt : fConverters ) {
-      std::string collectionName = cvt.first ;
+      if( skipLazy and cvt.second->IsLazy() ) {
+        std::cout << "WARNING: Memory budget exceeded, skipping lazy collection " << cvt.first << std::endl ;
+        continue ;
+      }
       EVENT::LCCollection *collection = nullptr ;
       try {
-        collection = event->getCollection( collectionName ) ;
+        collection = event->getCollection( cvt.first ) ;
       }
       catch( EVENT::DataNotAvailableException &e ) {
         std::cout << "Caught DataNotAvailableException: " << e.what() << std::endl ;
         continue ;
       }
+      collections.emplace_back( cvt.second->GetPriority( collection->getTypeName() ), &cvt.first, cvt.second.get(), collection ) ;
+    }
+    std::stable_sort( collections.begin(), collections.end(), []( const auto &lhs, const auto &rhs ){
+      return std::get<0>( lhs ) < std::get<0>( rhs ) ;
+    }) ;
+    std::vector<ICollectionConverter*> processed {} ;
+    for( auto &entry : collections ) {
+      const std::string &collectionName = *std::get<1>( entry ) ;
+      auto converter = std::get<2>( entry ) ;
+      auto collection = std::get<3>( entry ) ;
+      fCurrentScene = fScenes[ collectionName ] ;
       std::cout << "Loading collection " << collectionName << ", type " << collection->getTypeName() << ", " << collection->getNumberOfElements() << " elements" << std::endl ;
-      auto eveElement = cvt.second->ProcessCollection( collectionName, collection ) ;
+      ROOT::REveElement *eveElement = nullptr ;
+      {
+        Metrics::Timer timer( metrics, Metrics::Name( "lceve_convert_seconds", "collection", collectionName ) ) ;
+        LCEVE_TRACE_SCOPE( "ProcessCollection " + collectionName ) ;
+        eveElement = converter->ProcessCollection( collectionName, collection ) ;
+      }
+      processed.push_back( converter ) ;
+      metrics.Observe( Metrics::Name( "lceve_collection_size", "collection", collectionName ), collection->getNumberOfElements() ) ;
       if( nullptr != eveElement ) {
-        eventScene->AddElement( eveElement ) ;
+        metrics.Observe( Metrics::Name( "lceve_collection_elements", "collection", collectionName ), eveElement->NumChildren() ) ;
+        // large collections may already be partly streamed by their converter
+        if( nullptr == eveElement->GetMother() ) {
+          StreamElement( eveElement ) ;
+        }
+        metrics.Set( Metrics::Name( "lceve_streamed_seconds", "collection", collectionName ),
+          std::chrono::duration<double>( std::chrono::steady_clock::now() - eventStart ).count() ) ;
       }
     }
+    fCurrentScene = nullptr ;
+    // Post-processing, once all the elements of the event exist
+    for( auto converter : processed ) {
+      converter->EndOfEvent() ;
+    }
+    metrics.Set( "lceve_event_arena_bytes", fArena.GetUsedBytes() ) ;
+    metrics.Set( "lceve_registry_objects", fObjectRegistry.GetSize() ) ;
+    metrics.Set( "lceve_registry_reused", fObjectRegistry.GetReused() ) ;
+    metrics.Set( "lceve_registry_index_entries", fObjectRegistry.GetIndexSize() ) ;
+    std::size_t nRelations = 0 ;
+    for( auto &relations : fRelationIndices ) {
+      nRelations += relations.second.GetSize() ;
+    }
+    metrics.Set( "lceve_relations", nRelations ) ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  void EventConverter::StreamElement( ROOT::REveElement *element, ROOT::REveElement *parent ) {
+    if( nullptr == parent ) {
+      parent = fCurrentScene ;
+    }
+    if( nullptr == parent ) {
+      throw std::runtime_error( "EventConverter::StreamElement: no collection is being converted" ) ;
+    }
+    parent->AddElement( element ) ;
+    if( fProgressiveStreaming ) {
+      LCEVE_TRACE_SCOPE( "REveManager::DoRedraw3D" ) ;
+      // sends the changes of all scenes: only the new elements here
+      fEventDisplay->GetEveManager()->DoRedraw3D() ;
+    }
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  void EventConverter::SetProgressiveStreaming( bool progressive ) {
+    fProgressiveStreaming = progressive ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  const EventConverter::SceneMap_t &EventConverter::GetScenes() const {
+    return fScenes ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  bool EventConverter::IsEventElement( ROOT::REveElement *element ) const {
+    if( nullptr == element ) {
+      return false ;
+    }
+    while( nullptr != element->GetMother() ) {
+      element = element->GetMother() ;
+    }
+    for( auto &scene : fScenes ) {
+      if( element == scene.second ) {
+        return true ;
+      }
+    }
+    return false ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  ObjectRegistry &EventConverter::GetObjectRegistry() {
+    return fObjectRegistry ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  std::pmr::memory_resource *EventConverter::GetMemoryResource() {
+    return fArena.GetResource() ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  RelationIndex &EventConverter::GetRelationIndex( const std::string &collectionName ) {
+    return fRelationIndices[ collectionName ] ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  const EventConverter::RelationIndexMap_t &EventConverter::GetRelationIndices() const {
+    return fRelationIndices ;
   }
   
 }
@@ -4,7 +4,14 @@
 #include <LCEve/EventNavigator.h>
 #include <LCEve/EventConverter.h>
 #include <LCEve/Geometry.h>
+#include <LCEve/GeometryCache.h>
 #include <LCEve/LCEveConfig.h>
+#include <LCEve/Tracer.h>
+#include <LCEve/LCObjectFactory.h>
+#include <LCEve/EveElementFactory.h>
+#include <LCEve/ObjectRegistry.h>
+#include <LCEve/RelationIndex.h>
+#include <LCEve/CompactEncoding.h>
 
 // -- tclap headers
 #include <tclap/CmdLine.h>
@@ -12,18 +19,173 @@
 
 // -- root headers
 #include <ROOT/REveScene.hxx>
+#include <ROOT/REveJetCone.hxx>
+#include <ROOT/REveSelection.hxx>
+#include <ROOT/REveRenderData.hxx>
+#include <ROOT/RWebWindowsManager.hxx>
+#include <THttpServer.h>
+#include <TNamed.h>
+#include <TTimer.h>
 #include <TEnv.h>
 
 // -- lcio headers
 #include <EVENT/LCEvent.h>
+#include <EVENT/ReconstructedParticle.h>
+#include <EVENT/Track.h>
+#include <EVENT/Cluster.h>
+#include <EVENT/TrackerHit.h>
+#include <EVENT/CalorimeterHit.h>
 
 // -- tinyxml headers
 #include <tinyxml.h>
 
+// -- std headers
+#include <future>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_set>
+
 ClassImp( lceve::EventDisplay )
 
 namespace lceve {
 
+  /// Web server page serving the pipeline metrics in text format.
+  /// The text is re-generated on each access of the title
+  class MetricsPage : public TNamed {
+  public:
+    MetricsPage( Metrics &metrics ) :
+      TNamed( "metrics", "" ),
+      fMetrics(metrics) {
+      /* nop */
+    }
+
+    const char *GetTitle() const override {
+      fText = fMetrics.ToText() ;
+      return fText.c_str() ;
+    }
+
+  private:
+    Metrics                 &fMetrics ;
+    mutable std::string      fText {} ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  /// Single shot timer destroying the elements of the previous event
+  /// from the event loop, after the new event was sent to the clients
+  class TeardownTimer : public TTimer {
+  public:
+    TeardownTimer( EventDisplay *lced ) :
+      TTimer( 0, kTRUE ),
+      fEventDisplay(lced) {
+      /* nop */
+    }
+
+    Bool_t Notify() override {
+      TurnOff() ;
+      fEventDisplay->DestroyDetachedElements() ;
+      return kTRUE ;
+    }
+
+  private:
+    EventDisplay            *fEventDisplay {nullptr} ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  /// Get the size of the render data of an element tree, in bytes
+  static std::size_t RenderDataBytes( ROOT::REveElement *element ) {
+    std::size_t bytes = 0 ;
+    auto renderData = element->GetRenderData() ;
+    if( nullptr != renderData ) {
+      bytes += renderData->GetBinarySize() ;
+    }
+    for( auto child : element->RefChildren() ) {
+      bytes += RenderDataBytes( child ) ;
+    }
+    return bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Collect an object and the objects it refers to: tracks, clusters and
+  /// particles of a reco particle, hits of a track or a cluster
+  static void CollectRelated( const EVENT::LCObject *object, std::unordered_set<const EVENT::LCObject*> &related ) {
+    if( (nullptr == object) or (not related.insert( object ).second) ) {
+      return ;
+    }
+    if( auto particle = dynamic_cast<const EVENT::ReconstructedParticle*>( object ) ) {
+      for( auto track : particle->getTracks() ) {
+        CollectRelated( track, related ) ;
+      }
+      for( auto cluster : particle->getClusters() ) {
+        CollectRelated( cluster, related ) ;
+      }
+      for( auto daughter : particle->getParticles() ) {
+        CollectRelated( daughter, related ) ;
+      }
+    }
+    else if( auto track = dynamic_cast<const EVENT::Track*>( object ) ) {
+      for( auto hit : track->getTrackerHits() ) {
+        related.insert( hit ) ;
+      }
+    }
+    else if( auto cluster = dynamic_cast<const EVENT::Cluster*>( object ) ) {
+      for( auto hit : cluster->getCalorimeterHits() ) {
+        related.insert( hit ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Get the LCIO object shown by an element of the current event, nullptr if none
+  static const EVENT::LCObject *FindEventObject( ROOT::REveManager *manager, const EventConverter *converter, int elementId ) {
+    auto element = manager->FindElementById( elementId ) ;
+    if( (nullptr == element) or (nullptr == element->GetUserData()) ) {
+      std::cout << "WARNING: Element " << elementId << " doesn't show a LCIO object" << std::endl ;
+      return nullptr ;
+    }
+    // The LCIO objects are only valid while their event is displayed
+    if( not converter->IsEventElement( element ) ) {
+      std::cout << "WARNING: Element " << elementId << " doesn't belong to the current event" << std::endl ;
+      return nullptr ;
+    }
+    // The user data is always a LCIO object, with single inheritance from LCObject
+    return static_cast<const EVENT::LCObject*>( element->GetUserData() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// Highlight all the elements showing a set of objects: whole elements or points
+  /// of point sets (secondary selection). Returns the number of highlighted elements
+  static std::size_t HighlightObjects( ROOT::REveManager *manager, const ObjectRegistry &registry, const std::unordered_set<const EVENT::LCObject*> &objects ) {
+    // Group the index entries per element
+    std::map<ROOT::REveElement*, std::set<int>> elements {} ;
+    for( auto object : objects ) {
+      registry.ForEachEntry( object, [&]( const ObjectRegistry::Entry &entry ) {
+        auto &indices = elements[ entry.fElement ] ;
+        if( entry.fIndex >= 0 ) {
+          indices.insert( entry.fIndex ) ;
+        }
+      }) ;
+    }
+    manager->DisableRedraw() ;
+    auto highlight = manager->GetHighlight() ;
+    bool multi = false ;
+    for( auto &entry : elements ) {
+      const bool secondary = not entry.second.empty() ;
+      highlight->NewElementPicked( entry.first->GetElementId(), multi, secondary, entry.second ) ;
+      multi = true ;
+    }
+    manager->EnableRedraw() ;
+    manager->DoRedraw3D() ;
+    return elements.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
   EventDisplay::EventDisplay() {
     SetName( "EventDisplay" ) ;
     fNavigator = new EventNavigator( this ) ;
@@ -34,6 +196,8 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   EventDisplay::~EventDisplay() {
+    Tracer::Write() ;
+    fTeardownTimer = nullptr ;
     if(fApplication) delete fApplication ;
     delete fEventConverter ;
     delete fNavigator ;
@@ -66,12 +230,36 @@ namespace lceve {
 
   //--------------------------------------------------------------------------
 
+  EventConverter *EventDisplay::GetEventConverter() const  {
+    return fEventConverter ;
+  }
+
+  //--------------------------------------------------------------------------
+
   const Settings &EventDisplay::GetSettings() const {
     return fSettings ;
   }
 
   //--------------------------------------------------------------------------
 
+  TimingReport &EventDisplay::GetStartupReport() {
+    return fStartupReport ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  Metrics &EventDisplay::GetMetrics() {
+    return fMetrics ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  MemoryMonitor &EventDisplay::GetMemoryMonitor() {
+    return fMemoryMonitor ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void EventDisplay::Init( int argc, const char **argv ) {
     /// Create and parse the command line
     TCLAP::CmdLine cmd("LCEve: Linear Collider EVEnt display", ' ', "master") ;
@@ -104,41 +292,102 @@ namespace lceve {
       "The detector depth level to load", false, 1, "int") ;
     cmd.add( detectorLevelArg ) ;
 
+    TCLAP::ValueArg<std::string> geometryCacheArg( "k", "geometry-cache",
+      "The directory of the converted geometry cache", false, GeometryCache::DefaultDirectory(), "string") ;
+    cmd.add( geometryCacheArg ) ;
+
+    TCLAP::SwitchArg noGeometryCacheArg( "n", "no-geometry-cache",
+      "Do not read or write the converted geometry cache", false) ;
+    cmd.add( noGeometryCacheArg ) ;
+
+    TCLAP::ValueArg<std::string> memoryBudgetArg( "m", "memory-budget",
+      "The process memory budget (e.g 8G, 500M). Past it, the display degrades instead of growing further", false, "", "string") ;
+    cmd.add( memoryBudgetArg ) ;
+
+    TCLAP::ValueArg<std::string> traceArg( "t", "trace",
+      "Write a Chrome trace-event json file of the event display pipeline", false, "", "string") ;
+    cmd.add( traceArg ) ;
+
+    TCLAP::ValueArg<float> compactEncodingArg( "e", "compact-encoding",
+      "Send the event positions quantised to this resolution (cm) and delta-encoded. 0 for full precision", false, 0.f, "float") ;
+    cmd.add( compactEncodingArg ) ;
+
     cmd.parse( argc, argv ) ;
 
+    if( traceArg.isSet() ) {
+      Tracer::Enable( traceArg.getValue() ) ;
+    }
+
+    // Build the LCIO event index in the background, while creating the plugins and loading the geometry
+    std::future<void> lcioIndex {} ;
+    if( lcioFilesArg.isSet() ) {
+      auto fnames = lcioFilesArg.getValue() ;
+      lcioIndex = std::async( std::launch::async, [this, fnames](){
+        TimingReport::Scope timer( fStartupReport, "LCIO index" ) ;
+        fNavigator->Index( fnames ) ;
+      }) ;
+    }
+
     /// Fill the application settings with parsed values
     fSettings.SetServerMode( serverModeArg.getValue() ) ;
     fSettings.SetDetectorLevel( detectorLevelArg.getValue() ) ;
+    if( not noGeometryCacheArg.getValue() ) {
+      fSettings.SetGeometryCacheDirectory( geometryCacheArg.getValue() ) ;
+    }
+    fSettings.SetCompactEncodingResolution( std::max( 0.f, compactEncodingArg.getValue() ) ) ;
+    if( memoryBudgetArg.isSet() ) {
+      fSettings.SetMemoryBudget( MemoryMonitor::ParseSize( memoryBudgetArg.getValue() ) ) ;
+      fMemoryMonitor.SetBudget( fSettings.GetMemoryBudget() ) ;
+    }
     if( portArg.isSet() ) {
       gEnv->SetValue( "WebGui.HttpPort", portArg.getValue() ) ;
     }
 
-    // Create the ROOT application running the event loop
-    fApplication = new TApplication( "LCEve application", nullptr, nullptr ) ;
-
-    /// Create the Eve manager
-    fEveManager = ROOT::REveManager::Create() ;
-    fEveManager->GetWorld()->AddElement( this ) ;
+    {
+      TimingReport::Scope timer( fStartupReport, "Eve manager" ) ;
+      // Create the ROOT application running the event loop
+      fApplication = new TApplication( "LCEve application", nullptr, nullptr ) ;
+      /// Create the Eve manager
+      fEveManager = ROOT::REveManager::Create() ;
+      fEveManager->GetWorld()->AddElement( this ) ;
+    }
     
     TiXmlDocument document ;
-    bool loadOkay = document.LoadFile( configArg.getValue() ) ;
-    if( !loadOkay ) {
-      std::stringstream str ;
-      str  << "XMLParser::parse error in file [" << configArg.getValue()
-          << ", row: " << document.ErrorRow() << ", col: " << document.ErrorCol() << "] : "
-          << document.ErrorDesc() ;
-      throw std::runtime_error( str.str() ) ;
+    {
+      TimingReport::Scope timer( fStartupReport, "Config parsing" ) ;
+      bool loadOkay = document.LoadFile( configArg.getValue() ) ;
+      if( !loadOkay ) {
+        std::stringstream str ;
+        str  << "XMLParser::parse error in file [" << configArg.getValue()
+            << ", row: " << document.ErrorRow() << ", col: " << document.ErrorCol() << "] : "
+            << document.ErrorDesc() ;
+        throw std::runtime_error( str.str() ) ;
+      }
     }
     auto root = document.RootElement() ;
 
-    fEventConverter->Init( root ) ;
+    // Plugins and geometry both go through the DD4hep plugin manager
+    // which is not thread safe. They run in sequence on the main thread
+    {
+      TimingReport::Scope timer( fStartupReport, "Plugin instantiation" ) ;
+      fEventConverter->Init( root ) ;
+    }
     /// Load the DD4hep compact file
     fGeometry->LoadCompactFile( compactFileArg.getValue(), root ) ;
+    /// The compact encoding grid starts at the detector corner
+    if( fSettings.GetCompactEncodingResolution() > 0.f ) {
+      auto box = fGeometry->GetBoundingBox() ;
+      CompactEncoding::Enable( fSettings.GetCompactEncodingResolution(), { box[0], box[1], box[2] } ) ;
+    }
     /// Initialize the LCIO event navigator
     fNavigator->Init() ;
-    /// Open the LCIO files if any
-    if( lcioFilesArg.isSet() ) {
-      fNavigator->Open( lcioFilesArg.getValue() ) ;
+    /// Wait for the LCIO files to be opened, if any
+    if( lcioIndex.valid() ) {
+      {
+        TimingReport::Scope timer( fStartupReport, "Wait for LCIO index" ) ;
+        lcioIndex.get() ;
+      }
+      fNavigator->StampObjProps() ;
     }
 
     // Initialize OpenUI custom scripts
@@ -154,12 +403,20 @@ namespace lceve {
       std::cout << "Will start EveManager in server mode..." << std::endl ;
       gEnv->SetValue("WebEve.DisableShow", 1) ;
     }
+    PrintStartupReport() ;
   }
 
   //--------------------------------------------------------------------------
 
   void EventDisplay::Run() { 
     GetEveManager()->Show() ;
+    // Expose the pipeline metrics on the Eve web server
+    auto server = ROOT::RWebWindowsManager::Instance()->GetServer() ;
+    if( nullptr != server ) {
+      fMetricsPage = std::make_unique<MetricsPage>( fMetrics ) ;
+      server->Register( "/lceve", fMetricsPage.get() ) ;
+      std::cout << "Pipeline metrics available at /lceve/metrics/exe.txt?method=GetTitle" << std::endl ;
+    }
     GetApplication()->Run() ;
   }
 
@@ -168,22 +425,216 @@ namespace lceve {
   void EventDisplay::QuitRoot() {
     if( GetApplication() ) {
       std::cout << "Exiting application..." << std::endl ;
+      Tracer::Write() ;
       GetApplication()->Terminate() ;
     }
   }
 
   //--------------------------------------------------------------------------
 
+  void EventDisplay::ExpandGeometry( int elementId, int depth ) {
+    auto element = GetEveManager()->FindElementById( elementId ) ;
+    GetEveManager()->DisableRedraw() ;
+    if( (nullptr == element) or (not fGeometry->ExpandElement( element, depth )) ) {
+      std::cout << "WARNING: Element " << elementId << " is not an expandable geometry element" << std::endl ;
+    }
+    GetEveManager()->EnableRedraw() ;
+    GetEveManager()->DoRedraw3D() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::CollapseGeometry( int elementId ) {
+    auto element = GetEveManager()->FindElementById( elementId ) ;
+    GetEveManager()->DisableRedraw() ;
+    if( (nullptr == element) or (not fGeometry->CollapseElement( element )) ) {
+      std::cout << "WARNING: Element " << elementId << " is not an expandable geometry element" << std::endl ;
+    }
+    GetEveManager()->EnableRedraw() ;
+    GetEveManager()->DoRedraw3D() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::ExpandJet( int elementId ) {
+    auto jet = dynamic_cast<EveJet*>( GetEveManager()->FindElementById( elementId ) ) ;
+    if( (nullptr == jet) or (nullptr == jet->GetUserData()) ) {
+      std::cout << "WARNING: Element " << elementId << " is not an expandable jet" << std::endl ;
+      return ;
+    }
+    // The LCIO jet is only valid while its event is displayed
+    if( not fEventConverter->IsEventElement( jet ) ) {
+      std::cout << "WARNING: Jet " << elementId << " doesn't belong to the current event" << std::endl ;
+      return ;
+    }
+    if( jet->HasChildren() ) {
+      return ;
+    }
+    LCEVE_TRACE_SCOPE( "EventDisplay::ExpandJet" ) ;
+    auto lcJet = static_cast<const EVENT::ReconstructedParticle*>( jet->GetUserData() ) ;
+    LCObjectFactory lcFactory( this ) ;
+    EveElementFactory eveFactory( this ) ;
+    // Index the constituents (and their tracks and clusters) with the current event,
+    // as when they are built with the jet, for the highlighting and the relations
+    ObjectRegistry::Scope registryScope( fEventConverter->GetObjectRegistry(), false ) ;
+    GetEveManager()->DisableRedraw() ;
+    for( auto constituent : lcJet->getParticles() ) {
+      auto parameters = lcFactory.ConvertRecoParticle( constituent ) ;
+      parameters.fColor = jet->GetMainColor() ;
+      jet->AddElement( eveFactory.CreateRecoParticle( parameters ) ) ;
+    }
+    GetEveManager()->EnableRedraw() ;
+    GetEveManager()->DoRedraw3D() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::HighlightRelated( int elementId ) {
+    auto object = FindEventObject( GetEveManager(), fEventConverter, elementId ) ;
+    if( nullptr == object ) {
+      return ;
+    }
+    LCEVE_TRACE_SCOPE( "EventDisplay::HighlightRelated" ) ;
+    std::unordered_set<const EVENT::LCObject*> related {} ;
+    CollectRelated( object, related ) ;
+    auto nElements = HighlightObjects( GetEveManager(), fEventConverter->GetObjectRegistry(), related ) ;
+    fMetrics.Set( "lceve_highlight_elements", nElements ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::ShowTruth( int elementId ) {
+    auto object = FindEventObject( GetEveManager(), fEventConverter, elementId ) ;
+    if( nullptr == object ) {
+      return ;
+    }
+    LCEVE_TRACE_SCOPE( "EventDisplay::ShowTruth" ) ;
+    // The object and its links in both directions, in all the relation collections
+    std::unordered_set<const EVENT::LCObject*> linked { object } ;
+    for( auto &relations : fEventConverter->GetRelationIndices() ) {
+      auto print = [&]( const RelationIndex::Link &link ) {
+        std::cout << "  " << relations.first << ": " << link.fObject->id() << " (weight " << link.fWeight << ")" << std::endl ;
+        linked.insert( link.fObject ) ;
+      } ;
+      relations.second.ForEachTo( object, print ) ;
+      relations.second.ForEachFrom( object, print ) ;
+    }
+    if( 1 == linked.size() ) {
+      std::cout << "WARNING: No relation found for object " << object->id() << std::endl ;
+    }
+    auto nElements = HighlightObjects( GetEveManager(), fEventConverter->GetObjectRegistry(), linked ) ;
+    fMetrics.Set( "lceve_highlight_elements", nElements ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::SetSubdetectorLevel( const char *name, int level ) {
+    GetEveManager()->DisableRedraw() ;
+    if( not fGeometry->SetSubdetectorLevel( name, level ) ) {
+      std::cout << "WARNING: Subdetector " << name << " is not loaded" << std::endl ;
+    }
+    // Send the new levels to clients
+    StampObjProps() ;
+    GetEveManager()->EnableRedraw() ;
+    GetEveManager()->DoRedraw3D() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::PrintStartupReport() {
+    std::cout << "Startup timing report:" << std::endl ;
+    fStartupReport.Print( std::cout ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  int EventDisplay::WriteCoreJson(nlohmann::json &j, int /*rnr_offset*/) {
+    ROOT::REveElement::WriteCoreJson(j, -1) ;
+    auto subdetectors = nlohmann::json::array() ;
+    for( auto &subdet : fGeometry->GetSubdetectorLevels() ) {
+      subdetectors.push_back( { {"name", subdet.first}, {"level", subdet.second} } ) ;
+    }
+    j["subdetectors"] = subdetectors ;
+    j["startup"] = fStartupReport.ToJson() ;
+    return 0 ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void EventDisplay::VisualizeEvent( const EVENT::LCEvent *const event ) {
-    // Cleanup current event scene
+    LCEVE_TRACE_SCOPE( "EventDisplay::VisualizeEvent" ) ;
+    Metrics::Timer eventTimer( fMetrics, "lceve_event_seconds" ) ;
+    fMetrics.Increment( "lceve_events_total" ) ;
+    // Cleanup current event scenes
     GetEveManager()->DisableRedraw() ;
-    auto scene = GetEveManager()->GetEventScene() ;
-    scene->DestroyElements() ;
-    // Load new event in event scene
-    fEventConverter->VisualizeEvent( event, scene ) ;
-    /// Send event to clients
-    GetEveManager()->EnableRedraw();
-    GetEveManager()->DoRedraw3D();
+    {
+      Metrics::Timer timer( fMetrics, "lceve_scene_cleanup_seconds" ) ;
+      DetachEventElements() ;
+    }
+    // Account the decoded event and check the memory budget before converting it
+    fMemoryMonitor.SetEventBytes( MemoryMonitor::EstimateEventBytes( event ) ) ;
+    fMemoryMonitor.Update() ;
+    // Load new event in the collection scenes, sent to the clients collection by collection
+    CompactEncoding::ResetCounters() ;
+    fEventConverter->VisualizeEvent( event ) ;
+    /// Send the remaining changes to clients (e.g colors set at the end of the event)
+    {
+      Metrics::Timer timer( fMetrics, "lceve_redraw_seconds" ) ;
+      LCEVE_TRACE_SCOPE( "REveManager::DoRedraw3D" ) ;
+      GetEveManager()->EnableRedraw();
+      GetEveManager()->DoRedraw3D();
+    }
+    std::size_t renderDataBytes = 0 ;
+    std::size_t elementBytes = 0 ;
+    for( auto &scene : fEventConverter->GetScenes() ) {
+      renderDataBytes += RenderDataBytes( scene.second ) ;
+      elementBytes += MemoryMonitor::EstimateElementBytes( scene.second ) ;
+    }
+    fMetrics.Observe( "lceve_render_data_bytes", renderDataBytes ) ;
+    if( CompactEncoding::IsEnabled() ) {
+      // the positions of the streamed elements, with and without encoding
+      fMetrics.Set( "lceve_compact_raw_bytes", CompactEncoding::GetRawBytes() ) ;
+      fMetrics.Set( "lceve_compact_encoded_bytes", CompactEncoding::GetEncodedBytes() ) ;
+    }
+    fMemoryMonitor.SetElementBytes( elementBytes ) ;
+    fMemoryMonitor.Report( fMetrics ) ;
+    // Free the previous event from the event loop, off the critical path
+    if( not fDetachedElements.empty() ) {
+      if( nullptr == fTeardownTimer ) {
+        fTeardownTimer = std::make_unique<TeardownTimer>( this ) ;
+      }
+      fTeardownTimer->Start( 0, kTRUE ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::DetachEventElements() {
+    // The previous detached event was not freed yet: do it now
+    DestroyDetachedElements() ;
+    // Deny destruction while removing the elements from the scenes.
+    // The clients drop them now, the memory is freed later on
+    for( auto &scene : fEventConverter->GetScenes() ) {
+      for( auto element : scene.second->RefChildren() ) {
+        element->IncDenyDestroy() ;
+        fDetachedElements.push_back( element ) ;
+      }
+      scene.second->RemoveElements() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventDisplay::DestroyDetachedElements() {
+    if( fDetachedElements.empty() ) {
+      return ;
+    }
+    LCEVE_TRACE_SCOPE( "EventDisplay::DestroyDetachedElements" ) ;
+    Metrics::Timer timer( fMetrics, "lceve_deferred_teardown_seconds" ) ;
+    for( auto element : fDetachedElements ) {
+      element->DecDenyDestroy() ;
+    }
+    fDetachedElements.clear() ;
   }
 
 }
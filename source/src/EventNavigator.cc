@@ -3,6 +3,8 @@
 #include <LCEve/EventNavigator.h>
 #include <LCEve/EventDisplay.h>
 #include <LCEve/Geometry.h>
+#include <LCEve/Metrics.h>
+#include <LCEve/Tracer.h>
 
 // -- root headers
 #include <TApplication.h>
@@ -38,6 +40,14 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   void EventNavigator::Open( const std::vector<std::string> &fnames ) {
+    Index( fnames ) ;
+    StampObjProps();
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventNavigator::Index( const std::vector<std::string> &fnames ) {
+    LCEVE_TRACE_SCOPE( "EventNavigator::Index" ) ;
     _lcReader = std::make_unique<MT::LCReader>( MT::LCReader::directAccess ) ;
     _lcReader->open( fnames ) ;
     _runEventIds.clear() ;
@@ -65,12 +75,12 @@ namespace lceve {
       }
     }
     std::cout << "Loaded " << _runHeaderMap.size() << " run(s) from LCIO file" << std::endl ;
-    StampObjProps();
   }
 
   //--------------------------------------------------------------------------
 
   void EventNavigator::PreviousEvent() {
+    LCEVE_TRACE_SCOPE( "EventNavigator::PreviousEvent" ) ;
     if( (nullptr == _lcReader) or (_runEventIds.empty()) ) {
       std::cout << "No LCIO file opened. No data to display..." << std::endl ;
       StampObjProps();
@@ -83,7 +93,11 @@ namespace lceve {
     }
     _currentRunEvent--;
     auto iter = std::next( _runEventIds.begin(), _currentRunEvent ) ;
-    _currentEvent = _lcReader->readEvent( iter->first, iter->second ) ;
+    {
+      Metrics::Timer timer( _eventDisplay->GetMetrics(), "lceve_lcio_read_seconds" ) ;
+      LCEVE_TRACE_SCOPE( "LCReader::readEvent" ) ;
+      _currentEvent = _lcReader->readEvent( iter->first, iter->second ) ;
+    }
     StampObjProps();
     if( nullptr == _currentEvent ) {
       std::cout << "ERROR: read out nullptr event from lcio file" << std::endl ;
@@ -97,6 +111,7 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   void EventNavigator::NextEvent() {
+    LCEVE_TRACE_SCOPE( "EventNavigator::NextEvent" ) ;
     if( (nullptr == _lcReader) or (_runEventIds.empty()) ) {
       std::cout << "No LCIO file opened. No data to display..." << std::endl ;
       StampObjProps();
@@ -109,7 +124,11 @@ namespace lceve {
       return ;
     }
     _currentRunEvent++;
-    _currentEvent = _lcReader->readEvent( iter->first, iter->second ) ;
+    {
+      Metrics::Timer timer( _eventDisplay->GetMetrics(), "lceve_lcio_read_seconds" ) ;
+      LCEVE_TRACE_SCOPE( "LCReader::readEvent" ) ;
+      _currentEvent = _lcReader->readEvent( iter->first, iter->second ) ;
+    }
     StampObjProps();
     if( nullptr == _currentEvent ) {
       std::cout << "ERROR: read out nullptr event from lcio file" << std::endl ;
@@ -154,6 +173,7 @@ namespace lceve {
       j["date"] = "";
       j["detector"] = _eventDisplay->GetGeometry()->GetDetectorName() ;
     }
+    j["metrics"] = _eventDisplay->GetMetrics().Summary() ;
     j["UT_PostStream"] = "RefreshEventInfo" ;
     j["enableNavigation"] = ((_allowUserNavigation) and (nullptr != _lcReader)) ;
     return 0 ;
@@ -2,8 +2,14 @@
 // -- lceve headers
 #include <LCEve/EventDisplay.h>
 #include <LCEve/Geometry.h>
+#include <LCEve/GeometryCache.h>
+#include <LCEve/GeometryOptimizer.h>
 #include <LCEve/BField.h>
 #include <LCEve/XMLHelper.h>
+#include <LCEve/TimingReport.h>
+#include <LCEve/Tracer.h>
+#include <LCEve/CellIDPositionCache.h>
+#include <LCEve/MemoryMonitor.h>
 
 // -- root headers
 #include <ROOT/REveManager.hxx>
@@ -16,13 +22,13 @@
 #include <TGeoShape.h>
 #include <TGeoNode.h>
 #include <TGeoShapeAssembly.h>
+#include <TROOT.h>
 
 // -- dd4hep headers
 #include <DD4hep/Detector.h>
 #include <DD4hep/Objects.h>
 #include <DD4hep/DetElement.h>
 #include <DD4hep/Volumes.h>
-#include <XML/DocumentHandler.h>
 
 // -- tinyxml headers
 #include <tinyxml.h>
@@ -30,8 +36,22 @@
 // -- lcio headers
 #include <UTIL/BitField64.h>
 
+// -- std headers
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
 namespace lceve {
 
+  std::mutex Geometry::fgTGeoMutex {} ;
+
+  //--------------------------------------------------------------------------
+
   Geometry::Geometry( EventDisplay *lced ) :
     fEventDisplay(lced) {
     fBField = new BField(lced) ;
@@ -40,22 +60,42 @@ namespace lceve {
   //--------------------------------------------------------------------------
 
   Geometry::~Geometry() {
+    if( nullptr != fCellIDPositionCache ) {
+      fEventDisplay->GetMemoryMonitor().UnregisterCache( "cell id positions" ) ;
+    }
+    // The propagators are deleted with their last track
+    if( nullptr != fTrackPropagator ) {
+      fTrackPropagator->DecRefCount() ;
+    }
+    if( nullptr != fMCParticlePropagator ) {
+      fMCParticlePropagator->DecRefCount() ;
+    }
     delete fBField ;
+    ReleaseSharedShapes() ;
   }
 
   //--------------------------------------------------------------------------
 
   void Geometry::LoadCompactFile( const std::string &compactFile, const TiXmlElement *element ) {
+    LCEVE_TRACE_SCOPE( "Geometry::LoadCompactFile" ) ;
     if( GeometryLoaded() ) {
       std::cout << "WARNING: Geometry already loaded! Not loading again..." << std::endl ;
       return ;
     }
+    auto &report = fEventDisplay->GetStartupReport() ;
     dd4hep::Detector& theDetector = dd4hep::Detector::getInstance() ;
-    theDetector.fromCompact( compactFile ) ;
-    fDetectorName = ExtractDetectorName( compactFile ) ;
+    {
+      TimingReport::Scope timer( report, "Geometry: compact import" ) ;
+      LCEVE_TRACE_SCOPE( "dd4hep::Detector::fromCompact" ) ;
+      theDetector.fromCompact( compactFile ) ;
+    }
+    fDetectorName = ExtractDetectorName( theDetector, compactFile ) ;
     std::cout << "Detector name: "<< fDetectorName << std::endl ;
     std::cout << "Loading geometry in Eve. Please be patient..." << std::endl ;
     std::set<std::string> subdets {} ;
+    bool instanceShapes = true ;
+    bool mergeShapes = true ;
+    unsigned int triangleBudget = 200000 ;
     auto geoXML = element->FirstChildElement( "geometry" ) ;
     if( nullptr != geoXML ) {
       auto subdetsStr = XMLHelper::GetParameterValue( geoXML, "Subdetectors" ) ;
@@ -63,8 +103,44 @@ namespace lceve {
       UTIL::LCTokenizer tokenizer( subdetsVec, ' ' ) ;
       std::for_each( subdetsStr.begin(), subdetsStr.end(), tokenizer ) ;
       subdets.insert( subdetsVec.begin(), subdetsVec.end() ) ;
-    }    
-    LoadGeometry( theDetector, subdets ) ;
+      auto instanceStr = XMLHelper::GetParameterValue( geoXML, "InstanceShapes" ) ;
+      if( not instanceStr.empty() ) {
+        std::stringstream ss( instanceStr ) ;
+        if( (ss >> std::boolalpha >> instanceShapes).fail() ) {
+          throw std::runtime_error( "Geometry: invalid InstanceShapes parameter value '" + instanceStr + "'" ) ;
+        }
+      }
+      auto mergeStr = XMLHelper::GetParameterValue( geoXML, "MergeShapes" ) ;
+      if( not mergeStr.empty() ) {
+        std::stringstream ss( mergeStr ) ;
+        if( (ss >> std::boolalpha >> mergeShapes).fail() ) {
+          throw std::runtime_error( "Geometry: invalid MergeShapes parameter value '" + mergeStr + "'" ) ;
+        }
+      }
+      auto budgetStr = XMLHelper::GetParameterValue( geoXML, "TriangleBudget" ) ;
+      if( not budgetStr.empty() ) {
+        std::stringstream ss( budgetStr ) ;
+        if( (ss >> triangleBudget).fail() ) {
+          throw std::runtime_error( "Geometry: invalid TriangleBudget parameter value '" + budgetStr + "'" ) ;
+        }
+      }
+    }
+    GeometryOptimizer optimizer( instanceShapes, mergeShapes, triangleBudget ) ;
+    std::unique_ptr<GeometryCache> cache {nullptr} ;
+    auto cacheDir = fEventDisplay->GetSettings().GetGeometryCacheDirectory() ;
+    if( not cacheDir.empty() ) {
+      TimingReport::Scope timer( report, "Geometry: cache open" ) ;
+      cache = std::make_unique<GeometryCache>( cacheDir, compactFile, geoXML ) ;
+      cache->Open() ;
+    }
+    {
+      TimingReport::Scope timer( report, "Geometry: Eve conversion" ) ;
+      LoadGeometry( theDetector, subdets, optimizer, cache.get() ) ;
+    }
+    if( nullptr != cache ) {
+      TimingReport::Scope timer( report, "Geometry: cache write" ) ;
+      cache->Write() ;
+    }
     // Cache a few geometry variables
     this->CacheVariables() ;
     std::cout << "Loading geometry: done!" << std::endl ;
@@ -108,17 +184,80 @@ namespace lceve {
     prop->SetMaxOrbs(5) ;
     prop->SetMaxR( fMCParticleMaxR ) ;
     prop->SetMaxZ( fMCParticleMaxZ ) ;
+    // stop at the particle endpoint (decay path mark)
+    prop->SetFitDecay( true ) ;
     return prop ;
   }
 
   //--------------------------------------------------------------------------
 
+  ROOT::REveTrackPropagator *Geometry::GetTrackPropagator() {
+    if( nullptr == fTrackPropagator ) {
+      fTrackPropagator = CreateTrackPropagator() ;
+      // keep it alive when the tracks of an event are destroyed
+      fTrackPropagator->IncRefCount() ;
+    }
+    return fTrackPropagator ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveTrackPropagator *Geometry::GetMCParticlePropagator() {
+    if( nullptr == fMCParticlePropagator ) {
+      fMCParticlePropagator = CreateMCParticlePropagator() ;
+      // keep it alive when the MC particles of an event are destroyed
+      fMCParticlePropagator->IncRefCount() ;
+    }
+    return fMCParticlePropagator ;
+  }
+
+  //--------------------------------------------------------------------------
+
   ROOT::REveMagField *Geometry::GetBField() const {
     return fBField ;
   }
 
   //--------------------------------------------------------------------------
 
+  double Geometry::GetCalorimeterFaceR() const {
+    return fTrackMaxR ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  double Geometry::GetCalorimeterFaceZ() const {
+    return fTrackMaxZ ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::array<float,6> Geometry::GetBoundingBox() const {
+    std::array<float,6> box {} ;
+    auto shape = GetDetector().manager().GetTopVolume()->GetShape() ;
+    for( int axis=0 ; axis<3 ; ++axis ) {
+      double min(-1000.), max(1000.) ;
+      shape->GetAxisRange( axis+1, min, max ) ;
+      box[axis] = min ;
+      box[axis+3] = max ;
+    }
+    return box ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  CellIDPositionCache &Geometry::GetCellIDPositionCache() {
+    if( nullptr == fCellIDPositionCache ) {
+      fCellIDPositionCache = std::make_unique<CellIDPositionCache>( GetDetector() ) ;
+      auto cache = fCellIDPositionCache.get() ;
+      fEventDisplay->GetMemoryMonitor().RegisterCache( "cell id positions",
+        [cache](){ return cache->GetBytes() ; },
+        [cache](){ cache->Clear() ; } ) ;
+    }
+    return *fCellIDPositionCache ;
+  }
+
+  //--------------------------------------------------------------------------
+
   const dd4hep::rec::LayeredCalorimeterData *Geometry::GetLayeredCaloData(unsigned int includeFlag, unsigned int excludeFlag ) const {
 #pragma message "Move Geometry::GetLayeredCaloData method in a geometry helper class"
     dd4hep::Detector &mainDetector = dd4hep::Detector::getInstance() ;
@@ -136,8 +275,6 @@ namespace lceve {
     if (pv.isValid()) {
       TGeoNode* n = pv.ptr() ;
       TGeoMatrix* matrix = n->GetMatrix() ;
-      gGeoManager = nullptr ;
-      gGeoManager = new TGeoManager() ;
       ROOT::REveElement* e = CreateEveShape(0, levels, parent, n, *matrix, de.name()) ;
       if ( e )  {
         e->SetName( de.name() ) ;
@@ -181,6 +318,7 @@ namespace lceve {
       if ( vis.isValid() )  {
         float r,g,b;
         vis.rgb(r,g,b);
+        std::lock_guard<std::mutex> lock( fgTGeoMutex ) ;
         shape->SetMainColorRGB(r,g,b);
       }
       element = shape;
@@ -188,10 +326,23 @@ namespace lceve {
     }
     else if ( 0 == element )  {
       ROOT::REveGeoShape* shape = new ROOT::REveGeoShape(n->GetName());
-      if ( vis.isValid() )  {
-        float r,g,b;
-        vis.rgb(r,g,b);
-        shape->SetMainColorRGB(r,g,b);
+      {
+        // TColor and TGeoShape instances register in global ROOT lists
+        std::lock_guard<std::mutex> lock( fgTGeoMutex ) ;
+        if ( vis.isValid() )  {
+          float r,g,b;
+          vis.rgb(r,g,b);
+          shape->SetMainColorRGB(r,g,b);
+        }
+        // clone the shape only once per volume
+        auto iter = fSharedShapes.find(vol);
+        if ( fSharedShapes.end() == iter ) {
+          TGeoShape* clone = (TGeoShape*)geoShape->Clone();
+          // the map holds one reference
+          clone->SetUniqueID(1);
+          iter = fSharedShapes.emplace(vol, clone).first;
+        }
+        shape->SetShape(iter->second);
       }
       shape->SetEditMainTransparency( true ) ;
       shape->SetEditMainColor( true ) ;
@@ -199,7 +350,6 @@ namespace lceve {
       shape->SetMainAlpha(0.2);
       shape->SetPickable(true);
       shape->RefMainTrans().SetFrom(mat);
-      shape->SetShape((TGeoShape*)geoShape->Clone());
       if ( level < max_level ) {
         shape->SetRnrSelfChildren(true,true);
       }
@@ -219,41 +369,261 @@ namespace lceve {
       TGeoMatrix* matrix = daughter->GetMatrix();
       dau_mat.Multiply(matrix);
       ROOT::REveElement* dau_shape = CreateEveShape(level+1, max_level, element, daughter, dau_mat, daughter->GetName());
-      if ( dau_shape )  {
+      // daughters may already exist when expanding an element
+      if ( dau_shape && dau_shape->GetMother() != element )  {
         element->AddElement(dau_shape);
       }
     }
+    if ( level < max_level && element->HasChildren() ) {
+      element->SetRnrChildren(true);
+    }
     return element;
   }
 
   //--------------------------------------------------------------------------
 
-  void Geometry::LoadGeometry( dd4hep::Detector &detector, const std::set<std::string> &subdets ) {
+  void Geometry::LoadGeometry( dd4hep::Detector &detector, const std::set<std::string> &subdets, const GeometryOptimizer &optimizer, GeometryCache *cache ) {
+    LCEVE_TRACE_SCOPE( "Geometry::LoadGeometry" ) ;
     dd4hep::DetElement world = detector.world();
     int levels = fEventDisplay->GetSettings().GetDetectorLevel() ;
     const dd4hep::DetElement::Children& c = world.children();
     if ( c.size() == 0 )   {
       std::cout << "It looks like there is no Geometry loaded. No event display availible." << std::endl ;
+      return ;
+    }
+    if ( levels <= 0 ) {
+      return ;
     }
-    else if ( levels > 0 ) {
-      auto parent = fEventDisplay->GetEveManager()->GetGlobalScene() ;
-      for (auto i = c.begin(); i != c.end(); ++i) {
-        if( (not subdets.empty()) and (subdets.find( (*i).first ) == subdets.end() ) ) {
-          continue ;
+    // Shapes are cloned in a scratch geo manager, not in the DD4hep one, also
+    // when all subdetectors come from the cache: they are expanded later on
+    CreateScratchGeoManager() ;
+    // Select the subdetectors to load, in order
+    std::vector<std::pair<std::string, dd4hep::DetElement>> toLoad {} ;
+    for (auto i = c.begin(); i != c.end(); ++i) {
+      if( (not subdets.empty()) and (subdets.find( (*i).first ) == subdets.end() ) ) {
+        continue ;
+      }
+      toLoad.emplace_back( (*i).first, (*i).second ) ;
+    }
+    // Read out the cached subdetectors first
+    std::vector<ROOT::REveElement*> elements( toLoad.size(), nullptr ) ;
+    std::vector<std::size_t> toConvert {} ;
+    for( std::size_t i=0 ; i<toLoad.size() ; ++i ) {
+      elements[i] = (nullptr != cache) ? cache->ReadSubdetector( toLoad[i].first, levels ) : nullptr ;
+      if( nullptr != elements[i] ) {
+        std::cout << "  Loading detector " << toLoad[i].first << " from cache ..." << std::endl ;
+      }
+      else {
+        toConvert.push_back( i ) ;
+      }
+    }
+    if( not toConvert.empty() ) {
+      // Cloning goes through the ROOT streamers
+      ROOT::EnableThreadSafety() ;
+      // Convert the remaining subdetectors concurrently in detached elements
+      std::atomic<std::size_t> next {0} ;
+      std::vector<std::exception_ptr> errors( toConvert.size(), nullptr ) ;
+      // the shapes replaced by the optimizer are destroyed on this thread
+      std::vector<GeometryOptimizer::ElementList_t> replaced( toConvert.size() ) ;
+      auto worker = [&]() {
+        for( auto index = next++ ; index < toConvert.size() ; index = next++ ) {
+          auto &subdet = toLoad[ toConvert[index] ] ;
+          try {
+            LCEVE_TRACE_SCOPE( "Geometry::LoadDetElement " + subdet.first ) ;
+            elements[ toConvert[index] ] = LoadDetElement( subdet.second, levels, nullptr ) ;
+            optimizer.Optimize( elements[ toConvert[index] ], fgTGeoMutex, replaced[index] ) ;
+          }
+          catch( ... ) {
+            errors[index] = std::current_exception() ;
+          }
+        }
+      } ;
+      const std::size_t nThreads = std::min<std::size_t>( toConvert.size(), std::max( 1u, std::thread::hardware_concurrency() ) ) ;
+      std::cout << "  Converting " << toConvert.size() << " detector(s) using " << nThreads << " thread(s) ..." << std::endl ;
+      std::vector<std::thread> threads {} ;
+      threads.reserve( nThreads ) ;
+      for( std::size_t t=0 ; t<nThreads ; ++t ) {
+        threads.emplace_back( worker ) ;
+      }
+      for( auto &thread : threads ) {
+        thread.join() ;
+      }
+      for( auto &shapes : replaced ) {
+        GeometryOptimizer::DestroyReplaced( shapes ) ;
+      }
+      for( auto &error : errors ) {
+        if( nullptr != error ) {
+          std::rethrow_exception( error ) ;
         }
-        std::cout << "  Loading detector " << (*i).first << " ..." << std::endl ;
-        dd4hep::DetElement de = (*i).second ;
-        ROOT::REveElement* e = LoadDetElement(de, levels, parent);
-        if ( e )  {
-          parent->AddElement( e ) ;
+      }
+      if( nullptr != cache ) {
+        for( auto index : toConvert ) {
+          cache->AddSubdetector( toLoad[index].first, levels, elements[index] ) ;
         }
       }
     }
+    // Attach the subdetectors to the global scene, in order
+    auto parent = fEventDisplay->GetEveManager()->GetGlobalScene() ;
+    for( std::size_t i=0 ; i<toLoad.size() ; ++i ) {
+      if( nullptr != elements[i] ) {
+        std::cout << "  Loaded detector " << toLoad[i].first << std::endl ;
+        parent->AddElement( elements[i] ) ;
+        // Keep track of the geo nodes for on-demand expansion
+        TGeoNode *node = toLoad[i].second.placement().ptr() ;
+        RegisterElements( elements[i], node, *node->GetMatrix(), 0 ) ;
+        fSubdetectors[ toLoad[i].first ] = elements[i] ;
+        fSubdetectorLevels.emplace_back( toLoad[i].first, levels ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Geometry::CreateScratchGeoManager() {
+    // the shapes cloned so far belong to the previous scratch manager
+    ReleaseSharedShapes() ;
+    gGeoManager = nullptr ;
+    gGeoManager = new TGeoManager() ;
+    fScratchGeoManager = gGeoManager ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Geometry::ReleaseSharedShapes() {
+    // same reference counting as REveGeoShape: the last user deletes the shape
+    for( auto &entry : fSharedShapes ) {
+      auto shape = entry.second ;
+      shape->SetUniqueID( shape->GetUniqueID() - 1 ) ;
+      if( 0 == shape->GetUniqueID() ) {
+        delete shape ;
+      }
+    }
+    fSharedShapes.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Geometry::ExpandElement( ROOT::REveElement *element, int depth ) {
+    LCEVE_TRACE_SCOPE( "Geometry::ExpandElement" ) ;
+    auto iter = fGeometryNodes.find( element ) ;
+    if( fGeometryNodes.end() == iter or depth <= 0 ) {
+      return false ;
+    }
+    // copy, the map is modified on registration
+    GeometryNode node = iter->second ;
+    // the cloned shapes must not register in the DD4hep geo manager
+    if( nullptr == fScratchGeoManager ) {
+      CreateScratchGeoManager() ;
+    }
+    // merged shapes would overlap with the converted daughters
+    RemoveMergedElements( element ) ;
+    // already converted daughters are re-used, only the missing ones are created
+    CreateEveShape( node.fLevel, node.fLevel + depth, element, node.fNode, node.fMatrix, element->GetName() ) ;
+    RegisterElements( element, node.fNode, node.fMatrix, node.fLevel ) ;
+    element->SetRnrSelfChildren( element->GetRnrSelf(), true ) ;
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Geometry::CollapseElement( ROOT::REveElement *element ) {
+    if( fGeometryNodes.end() == fGeometryNodes.find( element ) ) {
+      return false ;
+    }
+    for( auto child : element->RefChildren() ) {
+      UnregisterElements( child ) ;
+    }
+    element->DestroyElements() ;
+    element->SetRnrSelfChildren( element->GetRnrSelf(), false ) ;
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Geometry::SetSubdetectorLevel( const std::string &name, int level ) {
+    auto iter = fSubdetectors.find( name ) ;
+    if( fSubdetectors.end() == iter ) {
+      return false ;
+    }
+    auto levelIter = std::find_if( fSubdetectorLevels.begin(), fSubdetectorLevels.end(), [&]( const std::pair<std::string, int> &l ) {
+      return l.first == name ;
+    }) ;
+    // lowering the level: unload everything below and re-expand up to the new level
+    if( level < levelIter->second ) {
+      CollapseElement( iter->second ) ;
+    }
+    if( level > 0 ) {
+      ExpandElement( iter->second, level ) ;
+    }
+    levelIter->second = level ;
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const std::vector<std::pair<std::string, int>> &Geometry::GetSubdetectorLevels() const {
+    return fSubdetectorLevels ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Geometry::RegisterElements( ROOT::REveElement *element, TGeoNode *node, const TGeoHMatrix& mat, int level ) {
+    if( nullptr == node or 0 == node->GetNdaughters() ) {
+      return ;
+    }
+    // elements read from the geometry cache have no user data
+    element->SetUserData( node ) ;
+    fGeometryNodes[ element ] = GeometryNode { node, mat, level } ;
+    for( auto child : element->RefChildren() ) {
+      TGeoNode *daughter = node->GetVolume()->FindNode( child->GetCName() ) ;
+      if( nullptr == daughter ) {
+        continue ;
+      }
+      TGeoHMatrix daughterMat( mat ) ;
+      daughterMat.Multiply( daughter->GetMatrix() ) ;
+      RegisterElements( child, daughter, daughterMat, level+1 ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Geometry::UnregisterElements( ROOT::REveElement *element ) {
+    fGeometryNodes.erase( element ) ;
+    for( auto child : element->RefChildren() ) {
+      UnregisterElements( child ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Geometry::RemoveMergedElements( ROOT::REveElement *element ) {
+    auto iter = fGeometryNodes.find( element ) ;
+    if( fGeometryNodes.end() == iter ) {
+      return ;
+    }
+    std::vector<ROOT::REveElement*> merged {} ;
+    for( auto child : element->RefChildren() ) {
+      if( nullptr == iter->second.fNode->GetVolume()->FindNode( child->GetCName() ) ) {
+        merged.push_back( child ) ;
+      }
+      else {
+        RemoveMergedElements( child ) ;
+      }
+    }
+    for( auto child : merged ) {
+      UnregisterElements( child ) ;
+      child->Destroy() ;
+    }
   }
 
   //--------------------------------------------------------------------------
 
-  std::string Geometry::ExtractDetectorName( const std::string &compactFile ) const {
+  std::string Geometry::ExtractDetectorName( const dd4hep::Detector &detector, const std::string &compactFile ) const {
+    // Filled from the <info> XML element while importing the compact file
+    auto header = detector.header() ;
+    if( header.isValid() and not header.name().empty() ) {
+      return header.name() ;
+    }
     std::string detectorName = compactFile ;
     auto last = detectorName.rfind( "/" ) ;
     if( last != std::string::npos ) {
@@ -263,18 +633,6 @@ namespace lceve {
     if( last != std::string::npos ) {
       detectorName = detectorName.substr( 0, last ) ;
     }
-    try {
-      dd4hep::xml::DocumentHandler handler;
-      auto doc = handler.load( compactFile ).root() ;
-      if( doc.hasChild("info") ) {
-        auto info = doc.child("info") ;
-        if( info.hasAttr("name") ) {
-          detectorName = info.attr_value( "name" ) ;
-          std::cout << "From compact file root/info attr name: " << detectorName << std::endl ;
-        }
-      }
-    }
-    catch(...) {}
     return detectorName ;
   }
   
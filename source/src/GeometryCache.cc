@@ -0,0 +1,365 @@
+// -- lceve headers
+#include <LCEve/GeometryCache.h>
+#include <LCEve/LCEveConfig.h>
+#include <LCEve/InstancedGeoShape.h>
+
+// -- root headers
+#include <ROOT/REveElement.hxx>
+#include <ROOT/REveGeoShape.hxx>
+#include <ROOT/REveGeoShapeExtract.hxx>
+#include <ROOT/REveTrans.hxx>
+#include <TFile.h>
+#include <TMemFile.h>
+#include <TList.h>
+#include <TColor.h>
+#include <TROOT.h>
+#include <TGeoManager.h>
+#include <TSystem.h>
+
+// -- tinyxml headers
+#include <tinyxml.h>
+
+// -- std headers
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+
+// -- posix headers
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace lceve {
+
+  GeometryCache::GeometryCache( const std::string &cacheDir, const std::string &compactFile, const TiXmlElement *geometry ) :
+    fDirectory(cacheDir) {
+    std::uint64_t hash = 14695981039346656037ULL ;
+    // the cache format may change between releases
+    const std::string release = LCEVE_RELEASE ;
+    HashBytes( release.c_str(), release.size(), hash ) ;
+    HashCompactFile( compactFile, hash, 0 ) ;
+    if( nullptr != geometry ) {
+      TiXmlPrinter printer ;
+      printer.SetIndent( "" ) ;
+      geometry->Accept( &printer ) ;
+      HashBytes( printer.CStr(), printer.Size(), hash ) ;
+    }
+    std::stringstream ss ;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash ;
+    fKey = ss.str() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  GeometryCache::~GeometryCache() {
+    Close() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::string GeometryCache::DefaultDirectory() {
+    auto env = std::getenv( "LCEVE_GEOMETRY_CACHE" ) ;
+    if( nullptr != env ) {
+      return env ;
+    }
+    auto home = std::getenv( "HOME" ) ;
+    if( nullptr != home ) {
+      return std::string( home ) + "/.cache/lceve" ;
+    }
+    return "" ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const std::string &GeometryCache::GetKey() const {
+    return fKey ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::string GeometryCache::GetFilePath() const {
+    return fDirectory + "/geometry-" + fKey + ".root" ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool GeometryCache::Open() {
+    Close() ;
+    auto path = GetFilePath() ;
+    int fd = ::open( path.c_str(), O_RDONLY ) ;
+    if( fd < 0 ) {
+      return false ;
+    }
+    struct stat st ;
+    if( ::fstat( fd, &st ) != 0 or st.st_size == 0 ) {
+      ::close( fd ) ;
+      return false ;
+    }
+    auto mapped = ::mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 ) ;
+    ::close( fd ) ;
+    if( MAP_FAILED == mapped ) {
+      std::cout << "WARNING: Couldn't map geometry cache file " << path << std::endl ;
+      return false ;
+    }
+    fMapped = mapped ;
+    fMappedSize = st.st_size ;
+    // read-only view on the mapped region: the TMemFile doesn't copy the buffer
+    fFile = std::make_unique<TMemFile>( path.c_str(), TMemFile::ZeroCopyView_t( static_cast<const char*>(fMapped), fMappedSize ) ) ;
+    if( fFile->IsZombie() ) {
+      std::cout << "WARNING: Invalid geometry cache file " << path << ", will be re-created" << std::endl ;
+      Close() ;
+      return false ;
+    }
+    std::cout << "Opened geometry cache file " << path << std::endl ;
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::Close() {
+    if( nullptr != fFile ) {
+      fFile->Close() ;
+      fFile = nullptr ;
+    }
+    if( nullptr != fMapped ) {
+      ::munmap( fMapped, fMappedSize ) ;
+      fMapped = nullptr ;
+      fMappedSize = 0 ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveElement *GeometryCache::ReadSubdetector( const std::string &name, int level ) const {
+    if( nullptr == fFile ) {
+      return nullptr ;
+    }
+    auto extract = dynamic_cast<ROOT::REveGeoShapeExtract*>( fFile->Get( EntryName( name, level ).c_str() ) ) ;
+    if( nullptr == extract ) {
+      return nullptr ;
+    }
+    auto element = ImportExtract( extract ) ;
+    delete extract ;
+    return element ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::AddSubdetector( const std::string &name, int level, ROOT::REveElement *element ) {
+    if( nullptr == element ) {
+      return ;
+    }
+    fStaged.emplace_back( EntryName( name, level ), std::unique_ptr<TObject>( DumpExtract( element ) ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  TGeoManager *GeometryCache::ReadGeoManager() const {
+    if( nullptr == fFile ) {
+      return nullptr ;
+    }
+    auto manager = dynamic_cast<TGeoManager*>( fFile->Get( "GeoManager" ) ) ;
+    if( nullptr != manager ) {
+      gGeoManager = manager ;
+      if( not manager->IsClosed() ) {
+        manager->CloseGeometry() ;
+      }
+    }
+    return manager ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::AddGeoManager( TGeoManager *manager ) {
+    fStagedManager = manager ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::Write() {
+    if( fStaged.empty() and nullptr == fStagedManager ) {
+      return ;
+    }
+    Close() ;
+    if( gSystem->mkdir( fDirectory.c_str(), true ) != 0 and gSystem->AccessPathName( fDirectory.c_str() ) ) {
+      std::cout << "WARNING: Couldn't create geometry cache directory " << fDirectory << std::endl ;
+      fStaged.clear() ;
+      fStagedManager = nullptr ;
+      return ;
+    }
+    auto path = GetFilePath() ;
+    std::unique_ptr<TFile> file( TFile::Open( path.c_str(), "UPDATE" ) ) ;
+    if( nullptr == file or file->IsZombie() ) {
+      file.reset( TFile::Open( path.c_str(), "RECREATE" ) ) ;
+    }
+    if( nullptr == file or file->IsZombie() ) {
+      std::cout << "WARNING: Couldn't write geometry cache file " << path << std::endl ;
+    }
+    else {
+      for( auto &entry : fStaged ) {
+        file->WriteTObject( entry.second.get(), entry.first.c_str(), "Overwrite" ) ;
+      }
+      if( nullptr != fStagedManager ) {
+        file->WriteTObject( fStagedManager, "GeoManager", "Overwrite" ) ;
+      }
+      file->Close() ;
+      std::cout << "Written " << fStaged.size() << " entries to geometry cache file " << path << std::endl ;
+    }
+    fStaged.clear() ;
+    fStagedManager = nullptr ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::string GeometryCache::EntryName( const std::string &name, int level ) {
+    return name + "_L" + std::to_string( level ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::HashCompactFile( const std::string &fname, std::uint64_t &hash, int depth ) {
+    // hash the file name in any case, so that a missing include still changes the key
+    HashBytes( fname.c_str(), fname.size(), hash ) ;
+    std::ifstream file( fname, std::ios::binary ) ;
+    if( not file ) {
+      return ;
+    }
+    std::stringstream content ;
+    content << file.rdbuf() ;
+    auto str = content.str() ;
+    HashBytes( str.c_str(), str.size(), hash ) ;
+    // follow the included files (gdml files, sub-detector compact files, etc ...)
+    if( depth > 16 ) {
+      return ;
+    }
+    TiXmlDocument document ;
+    document.Parse( str.c_str() ) ;
+    if( document.Error() ) {
+      return ;
+    }
+    auto last = fname.rfind( "/" ) ;
+    std::string directory = (last != std::string::npos) ? fname.substr( 0, last+1 ) : "" ;
+    std::vector<const TiXmlElement*> stack { document.RootElement() } ;
+    while( not stack.empty() ) {
+      auto element = stack.back() ;
+      stack.pop_back() ;
+      if( nullptr == element ) {
+        continue ;
+      }
+      const char *ref = element->Attribute( "ref" ) ;
+      const auto &tag = element->ValueStr() ;
+      if( nullptr != ref and (tag == "include" or tag == "gdmlFile" or tag == "file") ) {
+        std::string refStr( ref ) ;
+        HashCompactFile( (refStr.empty() or refStr[0] == '/') ? refStr : directory + refStr, hash, depth+1 ) ;
+      }
+      for( auto child = element->FirstChildElement() ; nullptr != child ; child = child->NextSiblingElement() ) {
+        stack.push_back( child ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryCache::HashBytes( const char *data, std::size_t size, std::uint64_t &hash ) {
+    for( std::size_t i=0 ; i<size ; ++i ) {
+      hash ^= static_cast<unsigned char>( data[i] ) ;
+      hash *= 1099511628211ULL ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveGeoShapeExtract *GeometryCache::DumpExtract( ROOT::REveElement *element ) {
+    auto extract = new ROOT::REveGeoShapeExtract( element->GetCName(), element->GetCTitle() ) ;
+    Float_t rgba[4] = { 1.f, 1.f, 1.f, 1.f } ;
+    auto color = gROOT->GetColor( element->GetMainColor() ) ;
+    if( nullptr != color ) {
+      color->GetRGB( rgba[0], rgba[1], rgba[2] ) ;
+    }
+    rgba[3] = 1.f - element->GetMainTransparency() / 100.f ;
+    extract->SetRGBA( rgba ) ;
+    extract->SetRGBALine( rgba ) ;
+    extract->SetRnrSelf( element->GetRnrSelf() ) ;
+    extract->SetRnrElements( element->GetRnrChildren() ) ;
+    // Assemblies have no shape and are stored as such
+    auto shape = dynamic_cast<ROOT::REveGeoShape*>( element ) ;
+    if( nullptr != shape ) {
+      extract->SetTrans( shape->RefMainTrans().Array() ) ;
+      extract->SetShape( shape->MakePolyShape() ) ;
+    }
+    // Instanced shapes store one child extract without shape per placement
+    auto instanced = dynamic_cast<InstancedGeoShape*>( element ) ;
+    if( nullptr != instanced ) {
+      extract->SetTitle( InstancedGeoShape::ExtractTitle() ) ;
+      extract->SetShape( instanced->MakePolyShape() ) ;
+      const auto &placements = instanced->RefPlacements() ;
+      for( std::size_t i=0 ; i<placements.size() ; i+=16 ) {
+        auto placement = new ROOT::REveGeoShapeExtract( element->GetCName(), element->GetCTitle() ) ;
+        placement->SetTrans( &placements[i] ) ;
+        extract->AddElement( placement ) ;
+      }
+      return extract ;
+    }
+    for( auto child : element->RefChildren() ) {
+      extract->AddElement( DumpExtract( child ) ) ;
+    }
+    return extract ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveElement *GeometryCache::ImportExtract( ROOT::REveGeoShapeExtract *extract ) {
+    ROOT::REveElement *element = nullptr ;
+    if( InstancedGeoShape::ExtractTitle() == std::string( extract->GetTitle() ) ) {
+      auto instanced = new InstancedGeoShape( extract->GetName() ) ;
+      // ownership of the shape is transferred to the instanced shape
+      instanced->SetShape( extract->GetShape() ) ;
+      extract->SetShape( nullptr ) ;
+      TIter next( extract->GetElements() ) ;
+      while( auto placement = dynamic_cast<ROOT::REveGeoShapeExtract*>( next() ) ) {
+        ROOT::REveTrans trans ;
+        trans.SetFromArray( placement->GetTrans() ) ;
+        instanced->AddInstance( trans ) ;
+      }
+      auto rgba = extract->GetRGBA() ;
+      instanced->SetEditMainTransparency( true ) ;
+      instanced->SetEditMainColor( true ) ;
+      instanced->SetMainColorRGB( rgba[0], rgba[1], rgba[2] ) ;
+      instanced->SetMainTransparency( true ) ;
+      instanced->SetMainAlpha( rgba[3] ) ;
+      instanced->SetPickable( true ) ;
+      instanced->SetRnrSelfChildren( extract->GetRnrSelf(), false ) ;
+      return instanced ;
+    }
+    if( nullptr == extract->GetShape() ) {
+      element = new ROOT::REveElement( extract->GetName(), extract->GetTitle() ) ;
+    }
+    else {
+      auto shape = new ROOT::REveGeoShape( extract->GetName(), extract->GetTitle() ) ;
+      shape->RefMainTrans().SetFromArray( extract->GetTrans() ) ;
+      // ownership of the shape is transferred to the eve shape
+      shape->SetShape( extract->GetShape() ) ;
+      extract->SetShape( nullptr ) ;
+      element = shape ;
+    }
+    auto rgba = extract->GetRGBA() ;
+    element->SetEditMainTransparency( true ) ;
+    element->SetEditMainColor( true ) ;
+    element->SetMainColorRGB( rgba[0], rgba[1], rgba[2] ) ;
+    element->SetMainTransparency( true ) ;
+    element->SetMainAlpha( rgba[3] ) ;
+    element->SetPickable( true ) ;
+    element->SetRnrSelfChildren( extract->GetRnrSelf(), extract->GetRnrElements() ) ;
+    if( extract->HasElements() ) {
+      TIter next( extract->GetElements() ) ;
+      while( auto child = dynamic_cast<ROOT::REveGeoShapeExtract*>( next() ) ) {
+        element->AddElement( ImportExtract( child ) ) ;
+      }
+    }
+    return element ;
+  }
+
+}
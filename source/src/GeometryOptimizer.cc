@@ -0,0 +1,385 @@
+// -- lceve headers
+#include <LCEve/GeometryOptimizer.h>
+#include <LCEve/InstancedGeoShape.h>
+
+// -- root headers
+#include <ROOT/REveElement.hxx>
+#include <ROOT/REveGeoShape.hxx>
+#include <ROOT/REveGeoPolyShape.hxx>
+#include <ROOT/REveTrans.hxx>
+#include <TGeoCompositeShape.h>
+#include <TString.h>
+
+// -- std headers
+#include <map>
+#include <tuple>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace lceve {
+
+  /**
+   *  @brief  MergedPolyShape class
+   *  A triangle mesh made of several tessellated shapes, in global coordinates
+   */
+  class MergedPolyShape : public ROOT::REveGeoPolyShape {
+  public:
+    /// Tessellate the shape of an eve shape and append it to the mesh
+    void Append( ROOT::REveGeoShape *shape, std::mutex &tgeoMutex ) ;
+    /// Decimate the mesh down to a maximum number of triangles
+    void Decimate( int maxTriangles ) ;
+    /// Update the bounding box after the mesh has been modified
+    void UpdateBoundingBox() ;
+    /// Get the number of triangles
+    int GetNTriangles() const ;
+
+  private:
+    using Triangle_t = std::array<Int_t, 3> ;
+    struct TriangleHash {
+      std::size_t operator()( const Triangle_t &t ) const {
+        return (static_cast<std::size_t>(t[0]) * 73856093) ^ (static_cast<std::size_t>(t[1]) * 19349663) ^ (static_cast<std::size_t>(t[2]) * 83492791) ;
+      }
+    };
+    /// Cluster the vertices on a regular grid of resolution^3 cells.
+    /// Returns the number of remaining triangles
+    int Cluster( int resolution, std::vector<Double_t> &vertices, std::vector<Int_t> &polys ) const ;
+
+    /// The minimum grid resolution used for decimation
+    static constexpr int    fgMinResolution = 4 ;
+    /// The maximum grid resolution used for decimation
+    static constexpr int    fgMaxResolution = 1024 ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  void MergedPolyShape::Append( ROOT::REveGeoShape *shape, std::mutex &tgeoMutex ) {
+    MergedPolyShape poly ;
+    {
+      // the shape tessellation uses static buffers
+      std::lock_guard<std::mutex> lock( tgeoMutex ) ;
+      auto geoShape = shape->GetShape() ;
+      auto composite = dynamic_cast<TGeoCompositeShape*>( geoShape ) ;
+      if( nullptr != composite ) {
+        poly.BuildFromComposite( composite, shape->GetNSegments() ) ;
+      }
+      else {
+        poly.BuildFromShape( geoShape, shape->GetNSegments() ) ;
+      }
+    }
+    if( not GetAutoEnforceTriangles() ) {
+      poly.EnforceTriangles() ;
+    }
+    const Int_t offset = fVertices.size() / 3 ;
+    const auto &trans = shape->RefMainTrans() ;
+    fVertices.reserve( fVertices.size() + poly.fVertices.size() ) ;
+    for( std::size_t i=0 ; i<poly.fVertices.size() ; i+=3 ) {
+      Double_t v[3] = { poly.fVertices[i], poly.fVertices[i+1], poly.fVertices[i+2] } ;
+      trans.MultiplyIP( v ) ;
+      fVertices.insert( fVertices.end(), v, v+3 ) ;
+    }
+    fPolyDesc.reserve( fPolyDesc.size() + poly.fPolyDesc.size() ) ;
+    for( Int_t p=0, j=0 ; p<poly.fNbPols ; ++p ) {
+      const Int_t n = poly.fPolyDesc[j] ;
+      fPolyDesc.push_back( n ) ;
+      for( Int_t k=0 ; k<n ; ++k ) {
+        fPolyDesc.push_back( poly.fPolyDesc[j+1+k] + offset ) ;
+      }
+      j += 1+n ;
+    }
+    fNbPols += poly.fNbPols ;
+    // normals are computed on the client side
+    fNormals.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MergedPolyShape::Decimate( int maxTriangles ) {
+    if( fNbPols <= maxTriangles ) {
+      return ;
+    }
+    // find the finest grid matching the budget
+    std::vector<Double_t> bestVertices {} ;
+    std::vector<Int_t> bestPolys {} ;
+    int bestCount = -1 ;
+    int low = fgMinResolution, high = fgMaxResolution ;
+    while( low <= high ) {
+      const int resolution = (low + high) / 2 ;
+      std::vector<Double_t> vertices {} ;
+      std::vector<Int_t> polys {} ;
+      const int count = Cluster( resolution, vertices, polys ) ;
+      if( count <= maxTriangles ) {
+        bestVertices.swap( vertices ) ;
+        bestPolys.swap( polys ) ;
+        bestCount = count ;
+        low = resolution + 1 ;
+      }
+      else {
+        high = resolution - 1 ;
+      }
+    }
+    // the budget can't be met without destroying the mesh
+    if( bestCount < 0 ) {
+      bestCount = Cluster( fgMinResolution, bestVertices, bestPolys ) ;
+    }
+    fVertices.swap( bestVertices ) ;
+    fPolyDesc.swap( bestPolys ) ;
+    fNbPols = bestCount ;
+    fNormals.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MergedPolyShape::UpdateBoundingBox() {
+    if( fVertices.empty() ) {
+      SetBoxDimensions( 0., 0., 0. ) ;
+      return ;
+    }
+    Double_t min[3], max[3] ;
+    for( int c=0 ; c<3 ; ++c ) {
+      min[c] = std::numeric_limits<Double_t>::max() ;
+      max[c] = std::numeric_limits<Double_t>::lowest() ;
+    }
+    for( std::size_t i=0 ; i<fVertices.size() ; i+=3 ) {
+      for( int c=0 ; c<3 ; ++c ) {
+        min[c] = std::min( min[c], fVertices[i+c] ) ;
+        max[c] = std::max( max[c], fVertices[i+c] ) ;
+      }
+    }
+    Double_t origin[3] = { 0.5*(min[0]+max[0]), 0.5*(min[1]+max[1]), 0.5*(min[2]+max[2]) } ;
+    SetBoxDimensions( 0.5*(max[0]-min[0]), 0.5*(max[1]-min[1]), 0.5*(max[2]-min[2]), origin ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  int MergedPolyShape::GetNTriangles() const {
+    return fNbPols ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  int MergedPolyShape::Cluster( int resolution, std::vector<Double_t> &vertices, std::vector<Int_t> &polys ) const {
+    const std::size_t nVertices = fVertices.size() / 3 ;
+    Double_t min[3], size[3] ;
+    for( int c=0 ; c<3 ; ++c ) {
+      Double_t max = std::numeric_limits<Double_t>::lowest() ;
+      min[c] = std::numeric_limits<Double_t>::max() ;
+      for( std::size_t i=0 ; i<nVertices ; ++i ) {
+        min[c] = std::min( min[c], fVertices[3*i+c] ) ;
+        max = std::max( max, fVertices[3*i+c] ) ;
+      }
+      size[c] = std::max( (max - min[c]) / resolution, std::numeric_limits<Double_t>::epsilon() ) ;
+    }
+    // map each vertex to its cell, the cell vertex is the mean of its vertices
+    std::unordered_map<std::uint64_t, Int_t> cells {} ;
+    std::vector<Int_t> remap( nVertices ) ;
+    std::vector<Double_t> sums {} ;
+    std::vector<Int_t> counts {} ;
+    for( std::size_t i=0 ; i<nVertices ; ++i ) {
+      std::uint64_t key = 0 ;
+      for( int c=0 ; c<3 ; ++c ) {
+        const auto index = std::min<std::uint64_t>( resolution - 1, static_cast<std::uint64_t>( (fVertices[3*i+c] - min[c]) / size[c] ) ) ;
+        key = key * resolution + index ;
+      }
+      auto inserted = cells.emplace( key, static_cast<Int_t>( counts.size() ) ) ;
+      if( inserted.second ) {
+        sums.insert( sums.end(), 3, 0. ) ;
+        counts.push_back( 0 ) ;
+      }
+      const Int_t cell = inserted.first->second ;
+      remap[i] = cell ;
+      for( int c=0 ; c<3 ; ++c ) {
+        sums[3*cell+c] += fVertices[3*i+c] ;
+      }
+      ++counts[cell] ;
+    }
+    vertices.resize( sums.size() ) ;
+    for( std::size_t cell=0 ; cell<counts.size() ; ++cell ) {
+      for( int c=0 ; c<3 ; ++c ) {
+        vertices[3*cell+c] = sums[3*cell+c] / counts[cell] ;
+      }
+    }
+    // remove the degenerated and duplicated triangles
+    std::unordered_set<Triangle_t, TriangleHash> triangles {} ;
+    polys.clear() ;
+    int count = 0 ;
+    for( Int_t p=0, j=0 ; p<fNbPols ; ++p ) {
+      const Int_t n = fPolyDesc[j] ;
+      if( 3 == n ) {
+        Triangle_t t = { remap[fPolyDesc[j+1]], remap[fPolyDesc[j+2]], remap[fPolyDesc[j+3]] } ;
+        if( t[0] != t[1] and t[1] != t[2] and t[0] != t[2] ) {
+          // same triangle, same orientation: rotate the smallest index first
+          std::rotate( t.begin(), std::min_element( t.begin(), t.end() ), t.end() ) ;
+          if( triangles.insert( t ).second ) {
+            polys.insert( polys.end(), { 3, t[0], t[1], t[2] } ) ;
+            ++count ;
+          }
+        }
+      }
+      j += 1+n ;
+    }
+    return count ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  GeometryOptimizer::GeometryOptimizer( bool instanceShapes, bool mergeShapes, unsigned int triangleBudget ) :
+    fInstanceShapes(instanceShapes),
+    fMergeShapes(mergeShapes),
+    fTriangleBudget(triangleBudget) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryOptimizer::Optimize( ROOT::REveElement *subdetector, std::mutex &tgeoMutex, ElementList_t &replaced ) const {
+    if( nullptr == subdetector ) {
+      return ;
+    }
+    // instancing first: repeated volumes are cheaper instanced than merged
+    if( fInstanceShapes ) {
+      InstanceShapes( subdetector, tgeoMutex, replaced ) ;
+    }
+    if( not fMergeShapes ) {
+      return ;
+    }
+    MeshList_t meshes {} ;
+    MergeShapes( subdetector, meshes, tgeoMutex, replaced ) ;
+    if( 0 == fTriangleBudget ) {
+      return ;
+    }
+    std::size_t nTriangles = 0 ;
+    for( auto mesh : meshes ) {
+      nTriangles += mesh->GetNTriangles() ;
+    }
+    if( nTriangles <= fTriangleBudget ) {
+      return ;
+    }
+    // share the budget among the meshes, proportionally to their size
+    const double fraction = static_cast<double>( fTriangleBudget ) / nTriangles ;
+    for( auto mesh : meshes ) {
+      mesh->Decimate( std::max( 12, static_cast<int>( mesh->GetNTriangles() * fraction ) ) ) ;
+      mesh->UpdateBoundingBox() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryOptimizer::InstanceShapes( ROOT::REveElement *element, std::mutex &tgeoMutex, ElementList_t &replaced ) const {
+    // group the leaf shapes by shared shape and visual attributes
+    using Key_t = std::tuple<TGeoShape*, Color_t, Char_t, Bool_t> ;
+    std::map<Key_t, std::vector<ROOT::REveGeoShape*>> groups {} ;
+    for( auto child : element->RefChildren() ) {
+      if( child->HasChildren() ) {
+        InstanceShapes( child, tgeoMutex, replaced ) ;
+        continue ;
+      }
+      auto shape = dynamic_cast<ROOT::REveGeoShape*>( child ) ;
+      if( (nullptr == shape) or (nullptr == shape->GetShape()) ) {
+        continue ;
+      }
+      groups[ Key_t { shape->GetShape(), shape->GetMainColor(), shape->GetMainTransparency(), shape->GetRnrSelf() } ].push_back( shape ) ;
+    }
+    int index = 0 ;
+    for( auto &group : groups ) {
+      auto &shapes = group.second ;
+      if( shapes.size() < 2 ) {
+        continue ;
+      }
+      auto name = element->GetName() + "_instances" + std::to_string( index++ ) ;
+      auto title = std::to_string( shapes.size() ) + " instances of " + shapes.front()->GetName() ;
+      auto instanced = new InstancedGeoShape( name, title ) ;
+      instanced->SetEditMainTransparency( true ) ;
+      instanced->SetEditMainColor( true ) ;
+      instanced->SetMainColor( std::get<1>( group.first ) ) ;
+      instanced->SetMainTransparency( std::get<2>( group.first ) ) ;
+      instanced->SetPickable( true ) ;
+      instanced->SetRnrSelfChildren( std::get<3>( group.first ), false ) ;
+      instanced->SetNSegments( shapes.front()->GetNSegments() ) ;
+      for( auto shape : shapes ) {
+        instanced->AddInstance( shape->RefMainTrans() ) ;
+      }
+      {
+        // shape reference counts are shared between subdetectors
+        std::lock_guard<std::mutex> lock( tgeoMutex ) ;
+        instanced->SetShape( std::get<0>( group.first ) ) ;
+      }
+      for( auto shape : shapes ) {
+        DetachReplaced( element, shape, replaced ) ;
+      }
+      element->AddElement( instanced ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryOptimizer::MergeShapes( ROOT::REveElement *element, MeshList_t &meshes, std::mutex &tgeoMutex, ElementList_t &replaced ) const {
+    // group the leaf shapes by visual attributes, in order
+    using Key_t = std::tuple<Color_t, Char_t, Bool_t> ;
+    std::map<Key_t, std::vector<ROOT::REveGeoShape*>> groups {} ;
+    for( auto child : element->RefChildren() ) {
+      if( child->HasChildren() ) {
+        MergeShapes( child, meshes, tgeoMutex, replaced ) ;
+        continue ;
+      }
+      auto shape = dynamic_cast<ROOT::REveGeoShape*>( child ) ;
+      if( (nullptr == shape) or (nullptr == shape->GetShape()) ) {
+        continue ;
+      }
+      groups[ Key_t { shape->GetMainColor(), shape->GetMainTransparency(), shape->GetRnrSelf() } ].push_back( shape ) ;
+    }
+    for( auto &group : groups ) {
+      auto &shapes = group.second ;
+      if( shapes.size() < 2 ) {
+        continue ;
+      }
+      auto mesh = new MergedPolyShape() ;
+      for( auto shape : shapes ) {
+        mesh->Append( shape, tgeoMutex ) ;
+      }
+      mesh->UpdateBoundingBox() ;
+      auto name = element->GetName() + "_merged" + std::to_string( meshes.size() ) ;
+      auto merged = new ROOT::REveGeoShape( name.c_str(), TString::Format( "%d merged shapes", static_cast<int>( shapes.size() ) ).Data() ) ;
+      merged->SetEditMainTransparency( true ) ;
+      merged->SetEditMainColor( true ) ;
+      merged->SetMainColor( std::get<0>( group.first ) ) ;
+      merged->SetMainTransparency( std::get<1>( group.first ) ) ;
+      merged->SetPickable( true ) ;
+      merged->SetRnrSelfChildren( std::get<2>( group.first ), false ) ;
+      {
+        // shape ownership and geo manager swapping are global
+        std::lock_guard<std::mutex> lock( tgeoMutex ) ;
+        merged->SetShape( mesh ) ;
+      }
+      for( auto shape : shapes ) {
+        DetachReplaced( element, shape, replaced ) ;
+      }
+      element->AddElement( merged ) ;
+      meshes.push_back( mesh ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryOptimizer::DestroyReplaced( ElementList_t &replaced ) {
+    // the last deny-destroy reference deletes the element
+    for( auto shape : replaced ) {
+      shape->DecDenyDestroy() ;
+    }
+    replaced.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void GeometryOptimizer::DetachReplaced( ROOT::REveElement *parent, ROOT::REveElement *shape, ElementList_t &replaced ) {
+    // the element would be deleted with its last parent, through the global Eve manager
+    shape->IncDenyDestroy() ;
+    parent->RemoveElement( shape ) ;
+    replaced.push_back( shape ) ;
+  }
+
+}
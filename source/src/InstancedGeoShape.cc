@@ -0,0 +1,128 @@
+// -- lceve headers
+#include <LCEve/InstancedGeoShape.h>
+
+// -- root headers
+#include <ROOT/REveGeoPolyShape.hxx>
+#include <ROOT/REveRenderData.hxx>
+#include <ROOT/REveTrans.hxx>
+#include <TGeoShape.h>
+#include <TGeoCompositeShape.h>
+
+// -- std headers
+#include <memory>
+
+ClassImp( lceve::InstancedGeoShape )
+
+namespace lceve {
+
+  InstancedGeoShape::InstancedGeoShape( const std::string &name, const std::string &title ) :
+    ROOT::REveElement( name, title ) {
+    SetMainColorPtr( &fColor ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  InstancedGeoShape::~InstancedGeoShape() {
+    SetShape( nullptr ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void InstancedGeoShape::SetShape( TGeoShape *shape ) {
+    if( nullptr != fShape ) {
+      fShape->SetUniqueID( fShape->GetUniqueID() - 1 ) ;
+      if( 0 == fShape->GetUniqueID() ) {
+        delete fShape ;
+      }
+    }
+    fShape = shape ;
+    if( nullptr != fShape ) {
+      fShape->SetUniqueID( fShape->GetUniqueID() + 1 ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  TGeoShape *InstancedGeoShape::GetShape() const {
+    return fShape ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void InstancedGeoShape::SetNSegments( int nSegments ) {
+    fNSegments = nSegments ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  int InstancedGeoShape::GetNSegments() const {
+    return fNSegments ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void InstancedGeoShape::AddInstance( const ROOT::REveTrans &trans ) {
+    const Double_t *array = trans.Array() ;
+    fPlacements.insert( fPlacements.end(), array, array+16 ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t InstancedGeoShape::GetNInstances() const {
+    return fPlacements.size() / 16 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const std::vector<Double_t> &InstancedGeoShape::RefPlacements() const {
+    return fPlacements ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveGeoPolyShape *InstancedGeoShape::MakePolyShape() const {
+    if( nullptr == fShape ) {
+      return nullptr ;
+    }
+    auto poly = new ROOT::REveGeoPolyShape() ;
+    auto composite = dynamic_cast<TGeoCompositeShape*>( fShape ) ;
+    if( nullptr != composite ) {
+      poly->BuildFromComposite( composite, fNSegments ) ;
+    }
+    else {
+      poly->BuildFromShape( fShape, fNSegments ) ;
+    }
+    return poly ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const char *InstancedGeoShape::ExtractTitle() {
+    return "lceve::InstancedGeoShape" ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  int InstancedGeoShape::WriteCoreJson( nlohmann::json &j, int rnr_offset ) {
+    auto ret = ROOT::REveElement::WriteCoreJson( j, rnr_offset ) ;
+    // the placement matrices are appended to the mesh vertices in the render data
+    j["fNInstances"] = GetNInstances() ;
+    return ret ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void InstancedGeoShape::BuildRenderData() {
+    std::unique_ptr<ROOT::REveGeoPolyShape> poly( MakePolyShape() ) ;
+    if( nullptr == poly ) {
+      return ;
+    }
+    fRenderData = std::make_unique<ROOT::REveRenderData>( "makeInstancedGeoShape" ) ;
+    ROOT::REveElement::BuildRenderData() ;
+    poly->FillRenderData( *fRenderData ) ;
+    for( auto value : fPlacements ) {
+      fRenderData->PushV( static_cast<float>( value ) ) ;
+    }
+  }
+
+}
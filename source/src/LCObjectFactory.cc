@@ -5,6 +5,18 @@
 #include <LCEve/BField.h>
 #include <LCEve/HelixClass.h>
 #include <LCEve/ParticleHelper.h>
+#include <LCEve/CellIDPositionCache.h>
+#include <LCEve/LCIOHelper.h>
+#include <LCEve/EventConverter.h>
+#include <LCEve/ObjectRegistry.h>
+
+// -- root headers
+#include <TVector2.h>
+
+// -- std headers
+#include <cmath>
+#include <algorithm>
+#include <iostream>
 
 namespace lceve {
   
@@ -55,14 +67,17 @@ namespace lceve {
       EVENT::TrackState::AtLastHit,  
       EVENT::TrackState::AtCalorimeter
     } ;
+    ArenaVector<TrackState> trackStates( this->GetMemoryResource() ) ;
+    trackStates.reserve( tsTypes.size() ) ;
     for( auto tst : tsTypes ) {
       auto trackState = track->getTrackState(tst) ;
       if( nullptr != trackState ) {
         auto trackStateParameters = ConvertTrackState( trackState ) ;
-        parameters.fTrackStates.push_back( trackStateParameters ) ;
+        trackStates.push_back( std::move( trackStateParameters ) ) ;
       }
       // TODO add track state parameters to track properties
     }
+    parameters.fTrackStates = std::move( trackStates ) ;
     auto ref = track->getTrackState( EVENT::TrackState::AtFirstHit ) ;
     auto p = ref->getReferencePoint() ;
     parameters.fReferencePoint = ROOT::REveVectorT<float>( p[0]*0.1, p[1]*0.1, p[2]*0.1 ) ;
@@ -73,6 +88,7 @@ namespace lceve {
       ref->getPhi(), ref->getD0(), ref->getZ0(), 
       ref->getOmega(), ref->getTanLambda(), bfield ) ;
     parameters.fMomentum = ROOT::REveVectorT<float>( helix.getMomentum() ) ;
+    parameters.fUserData = const_cast<EVENT::Track*>( track ) ;
     return parameters ;
   }
   
@@ -109,11 +125,11 @@ namespace lceve {
   //--------------------------------------------------------------------------
   
   template <typename T>
-  std::vector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<T*> &caloHits ) const {
+  ArenaVector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<T*> &caloHits ) const {
     if( caloHits.empty() ) {
       return {} ;
     }
-    std::vector<CaloHitParameters> parametersList {} ;
+    ArenaVector<CaloHitParameters> parametersList( this->GetMemoryResource() ) ;
     parametersList.reserve( caloHits.size() ) ;
     auto color = ColorHelper::RandomColor( *caloHits.begin() ) ;
     for( auto &caloHit : caloHits ) {
@@ -122,8 +138,44 @@ namespace lceve {
       parameters.fPosition = ROOT::REveVectorT<float>( pos[0]*0.1, pos[1]*0.1, pos[2]*0.1 ) ;
       parameters.fColor = color ;
       parameters.fAmplitude = caloHit->getEnergy() ;
-      parametersList.push_back( parameters ) ;
+      parameters.fUserData = caloHit ;
+      parametersList.push_back( std::move( parameters ) ) ;
+    }
+    return parametersList ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  template <>
+  ArenaVector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::RawCalorimeterHit*> &caloHits ) const {
+    if( caloHits.empty() ) {
+      return {} ;
+    }
+    auto &positionCache = fEventDisplay->GetGeometry()->GetCellIDPositionCache() ;
+    ArenaVector<CaloHitParameters> parametersList( this->GetMemoryResource() ) ;
+    parametersList.reserve( caloHits.size() ) ;
+    auto color = ColorHelper::RandomColor( *caloHits.begin() ) ;
+    std::size_t nInvalid = 0 ;
+    for( auto &caloHit : caloHits ) {
+      auto position = positionCache.GetPosition( LCIOHelper::GetCellID( caloHit ) ) ;
+      if( not position.has_value() ) {
+        ++nInvalid ;
+        continue ;
+      }
+      CaloHitParameters parameters {} ;
+      parameters.fPosition = position ;
+      parameters.fColor = color ;
+      parameters.fAmplitude = LCIOHelper::GetEnergy( caloHit ) ;
+      parameters.fUserData = caloHit ;
+      parametersList.push_back( std::move( parameters ) ) ;
     }
+    if( nInvalid > 0 ) {
+      std::cout << "WARNING: " << nInvalid << " raw calorimeter hit(s) with unknown cell id" << std::endl ;
+    }
+    auto &metrics = fEventDisplay->GetMetrics() ;
+    metrics.Set( "lceve_cellid_cache_entries", positionCache.GetSize() ) ;
+    metrics.Set( "lceve_cellid_cache_hits", positionCache.GetHits() ) ;
+    metrics.Set( "lceve_cellid_cache_misses", positionCache.GetMisses() ) ;
     return parametersList ;
   }
   
@@ -137,6 +189,7 @@ namespace lceve {
     parameters.fMarkerAttributes = attr ;
     parameters.fEnergy = cluster->getEnergy() ;
     parameters.fCaloHits = this->ConvertCaloHits( cluster->getCalorimeterHits() ) ;
+    parameters.fUserData = const_cast<EVENT::Cluster*>( cluster ) ;
     return parameters ;
   }
   
@@ -148,29 +201,84 @@ namespace lceve {
     parameters.fMomentum = ROOT::REveVectorT<float>( recoParticle->getMomentum() ) ;
     parameters.fMass = recoParticle->getMass() ;
     parameters.fColor = ColorHelper::RandomColor( recoParticle ) ;
+    parameters.fUserData = const_cast<EVENT::ReconstructedParticle*>( recoParticle ) ;
+    // Tracks and clusters already created for another collection are only referenced
+    auto converter = fEventDisplay->GetEventConverter() ;
+    auto registry = (nullptr == converter) ? nullptr : &converter->GetObjectRegistry() ;
     auto &tracks = recoParticle->getTracks() ;
     if( not tracks.empty() ) {
-      std::vector<TrackParameters> trackParams {} ;
+      ArenaVector<TrackParameters> trackParams( this->GetMemoryResource() ) ;
       trackParams.reserve( tracks.size() ) ;
       for( auto &trk : tracks ) {
+        if( (nullptr != registry) and (nullptr != registry->Find<EveTrack>( trk )) ) {
+          TrackParameters reference {} ;
+          reference.fUserData = trk ;
+          trackParams.push_back( std::move( reference ) ) ;
+          continue ;
+        }
         trackParams.push_back( this->ConvertTrack( trk ) ) ;
       }
-      parameters.fTracks = trackParams ;
+      parameters.fTracks = std::move( trackParams ) ;
     }
     auto &clusters = recoParticle->getClusters() ;
     if( not clusters.empty() ) {
-      std::vector<ClusterParameters> clusterParams {} ;
+      ArenaVector<ClusterParameters> clusterParams( this->GetMemoryResource() ) ;
       clusterParams.reserve( clusters.size() ) ;
       for( auto &cl : clusters ) {
+        if( (nullptr != registry) and (nullptr != registry->Find<EveCluster>( cl )) ) {
+          ClusterParameters reference {} ;
+          reference.fUserData = cl ;
+          clusterParams.push_back( std::move( reference ) ) ;
+          continue ;
+        }
         clusterParams.push_back( this->ConvertCluster( cl ) ) ;
       }
-      parameters.fClusters = clusterParams ;
+      parameters.fClusters = std::move( clusterParams ) ;
     }
     return parameters ;
   }
   
   //--------------------------------------------------------------------------
   
+  JetParameters LCObjectFactory::ConvertJet( const EVENT::ReconstructedParticle *const jet, bool withConstituents ) const {
+    JetParameters parameters {} ;
+    const ROOT::REveVectorT<float> momentum( jet->getMomentum() ) ;
+    parameters.fEnergy = jet->getEnergy() ;
+    parameters.fMomentum = momentum ;
+    parameters.fMass = jet->getMass() ;
+    parameters.fColor = ColorHelper::RandomColor( jet ) ;
+    auto &constituents = jet->getParticles() ;
+    parameters.fNConstituents = constituents.size() ;
+    // Cone radius from the constituent directions only. Nothing else is converted
+    float coneRadius = 0.f ;
+    for( auto constituent : constituents ) {
+      const ROOT::REveVectorT<float> direction( constituent->getMomentum() ) ;
+      if( direction.Perp2() <= 0.f ) {
+        continue ;
+      }
+      const float deltaEta = direction.Eta() - momentum.Eta() ;
+      const float deltaPhi = TVector2::Phi_mpi_pi( direction.Phi() - momentum.Phi() ) ;
+      coneRadius = std::max( coneRadius, std::sqrt( deltaEta*deltaEta + deltaPhi*deltaPhi ) ) ;
+    }
+    parameters.fConeParameters = std::array<float,3> { momentum.Eta(), momentum.Phi(), coneRadius } ;
+    if( withConstituents and not constituents.empty() ) {
+      ArenaVector<RecoParticleParameters> particles( this->GetMemoryResource() ) ;
+      particles.reserve( constituents.size() ) ;
+      for( auto constituent : constituents ) {
+        particles.push_back( this->ConvertRecoParticle( constituent ) ) ;
+      }
+      parameters.fParticles = std::move( particles ) ;
+    }
+    parameters.fUserData = const_cast<EVENT::ReconstructedParticle*>( jet ) ;
+    PropertyMap properties ;
+    properties["Type"] = jet->getType() ;
+    properties["Constituents"] = constituents.size() ;
+    parameters.fProperties = properties ;
+    return parameters ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
   MCParticleParameters LCObjectFactory::ConvertMCParticle( const EVENT::MCParticle *const mcp ) const {
     
     auto color = ColorHelper::RandomColor( mcp ) ;
@@ -193,14 +301,25 @@ namespace lceve {
     auto ep = mcp->getEndpoint() ;
     parameters.fVertexPosition = ROOT::REveVectorT<float>( v[0]*0.1, v[1]*0.1, v[2]*0.1 ) ;
     parameters.fVertexMomentum = ROOT::REveVectorT<float>( mcp->getMomentum() ) ;
-    parameters.fEndpointPosition = ROOT::REveVectorT<float>( ep[0]*0.1, ep[1]*0.1, ep[2]*0.1 ) ;
-    parameters.fEndpointMomentum = ROOT::REveVectorT<float>( mcp->getMomentumAtEndpoint() ) ;
+    // LCIO leaves the endpoint at the origin when the particle doesn't stop in the detector
+    if( ( 0. != ep[0] ) or ( 0. != ep[1] ) or ( 0. != ep[2] ) ) {
+      parameters.fEndpointPosition = ROOT::REveVectorT<float>( ep[0]*0.1, ep[1]*0.1, ep[2]*0.1 ) ;
+      parameters.fEndpointMomentum = ROOT::REveVectorT<float>( mcp->getMomentumAtEndpoint() ) ;
+    }
+    parameters.fUserData = const_cast<EVENT::MCParticle*>( mcp ) ;
     
     return parameters ;
   }
   
   //--------------------------------------------------------------------------
   
-  template std::vector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::CalorimeterHit*> &caloHits ) const ;
-  template std::vector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::SimCalorimeterHit*> &caloHits ) const ;
+  std::pmr::memory_resource *LCObjectFactory::GetMemoryResource() const {
+    auto converter = fEventDisplay->GetEventConverter() ;
+    return (nullptr == converter) ? std::pmr::new_delete_resource() : converter->GetMemoryResource() ;
+  }
+  
+  //--------------------------------------------------------------------------
+  
+  template ArenaVector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::CalorimeterHit*> &caloHits ) const ;
+  template ArenaVector<CaloHitParameters> LCObjectFactory::ConvertCaloHits( const std::vector<EVENT::SimCalorimeterHit*> &caloHits ) const ;
 }
\ No newline at end of file
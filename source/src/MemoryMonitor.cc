@@ -0,0 +1,239 @@
+// -- lceve headers
+#include <LCEve/MemoryMonitor.h>
+#include <LCEve/Metrics.h>
+
+// -- root headers
+#include <ROOT/REveElement.hxx>
+#include <ROOT/REvePointSet.hxx>
+#include <ROOT/REveRenderData.hxx>
+
+// -- lcio headers
+#include <EVENT/LCEvent.h>
+#include <EVENT/LCCollection.h>
+#include <EVENT/LCIO.h>
+
+// -- std headers
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <map>
+
+// -- posix headers
+#include <unistd.h>
+#include <sys/resource.h>
+
+namespace lceve {
+
+  void MemoryMonitor::SetBudget( std::size_t bytes ) {
+    fBudget = bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::GetBudget() const {
+    return fBudget ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::RegisterCache( const std::string &name, SizeFunction size, DropFunction drop ) {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    fCaches.push_back( Cache { name, std::move(size), std::move(drop) } ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::UnregisterCache( const std::string &name ) {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    fCaches.erase( std::remove_if( fCaches.begin(), fCaches.end(), [&]( const Cache &cache ){
+      return cache.fName == name ;
+    }), fCaches.end() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::GetCacheBytes() const {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    std::size_t bytes = 0 ;
+    for( auto &cache : fCaches ) {
+      bytes += cache.fSize() ;
+    }
+    return bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::DropCaches() {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    for( auto &cache : fCaches ) {
+      cache.fDrop() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::SetEventBytes( std::size_t bytes ) {
+    fEventBytes = bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::SetElementBytes( std::size_t bytes ) {
+    fElementBytes = bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  MemoryMonitor::Degradation MemoryMonitor::Update() {
+    auto previous = fDegradation ;
+    fDegradation = Degradation::None ;
+    if( 0 != fBudget ) {
+      auto resident = GetResidentBytes() ;
+      if( resident > fBudget ) {
+        DropCaches() ;
+        fDegradation = Degradation::DropCaches ;
+        // freed memory is not always given back to the system: re-check anyway
+        resident = GetResidentBytes() ;
+        if( resident > fBudget ) {
+          fDegradation = (resident > fBudget + fBudget/4) ? Degradation::SkipLazy : Degradation::LevelOfDetail ;
+        }
+      }
+    }
+    if( previous != fDegradation ) {
+      std::cout << "WARNING: Memory budget: degradation level changed from " << static_cast<int>( previous )
+                << " to " << static_cast<int>( fDegradation ) << std::endl ;
+    }
+    return fDegradation ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  MemoryMonitor::Degradation MemoryMonitor::GetDegradation() const {
+    return fDegradation ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void MemoryMonitor::Report( Metrics &metrics ) const {
+    auto resident = GetResidentBytes() ;
+    auto caches = GetCacheBytes() ;
+    std::cout << "Memory: resident " << resident / (1024*1024) << " MB"
+              << ", event ~" << fEventBytes / (1024*1024) << " MB"
+              << ", elements ~" << fElementBytes / (1024*1024) << " MB"
+              << ", caches " << caches / (1024*1024) << " MB" ;
+    if( 0 != fBudget ) {
+      std::cout << ", budget " << fBudget / (1024*1024) << " MB" ;
+    }
+    std::cout << std::endl ;
+    metrics.Set( "lceve_memory_resident_bytes", resident ) ;
+    metrics.Set( "lceve_memory_event_bytes", fEventBytes ) ;
+    metrics.Set( "lceve_memory_element_bytes", fElementBytes ) ;
+    metrics.Set( "lceve_memory_cache_bytes", caches ) ;
+    metrics.Set( "lceve_memory_budget_bytes", fBudget ) ;
+    metrics.Set( "lceve_memory_degradation", static_cast<int>( fDegradation ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::GetResidentBytes() {
+    std::ifstream statm( "/proc/self/statm" ) ;
+    std::size_t size(0), resident(0) ;
+    if( not (statm >> size >> resident) ) {
+      return 0 ;
+    }
+    return resident * static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::GetPeakResidentBytes() {
+    struct rusage usage ;
+    if( 0 != ::getrusage( RUSAGE_SELF, &usage ) ) {
+      return 0 ;
+    }
+    // ru_maxrss is given in kilobytes on Linux
+    return static_cast<std::size_t>( usage.ru_maxrss ) * 1024 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::EstimateEventBytes( const EVENT::LCEvent *const event ) {
+    // Rough in-memory size of the LCIO objects, including their vectors
+    static const std::map<std::string, std::size_t> objectSizes = {
+      { EVENT::LCIO::MCPARTICLE, 200 },
+      { EVENT::LCIO::SIMTRACKERHIT, 120 },
+      { EVENT::LCIO::SIMCALORIMETERHIT, 160 },
+      { EVENT::LCIO::TRACKERHIT, 150 },
+      { EVENT::LCIO::TRACKERHITPLANE, 170 },
+      { EVENT::LCIO::CALORIMETERHIT, 100 },
+      { EVENT::LCIO::RAWCALORIMETERHIT, 48 },
+      { EVENT::LCIO::TRACK, 400 },
+      { EVENT::LCIO::CLUSTER, 300 },
+      { EVENT::LCIO::RECONSTRUCTEDPARTICLE, 300 },
+      { EVENT::LCIO::VERTEX, 200 },
+      { EVENT::LCIO::LCRELATION, 48 }
+    } ;
+    if( nullptr == event ) {
+      return 0 ;
+    }
+    std::size_t bytes = 0 ;
+    auto names = event->getCollectionNames() ;
+    for( auto &name : *names ) {
+      auto collection = event->getCollection( name ) ;
+      auto iter = objectSizes.find( collection->getTypeName() ) ;
+      const std::size_t objectSize = (objectSizes.end() == iter) ? 128 : iter->second ;
+      bytes += collection->getNumberOfElements() * (objectSize + sizeof(void*)) ;
+    }
+    return bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::EstimateElementBytes( ROOT::REveElement *element ) {
+    std::size_t bytes = sizeof( ROOT::REveElement ) ;
+    auto pointSet = dynamic_cast<ROOT::REvePointSet*>( element ) ;
+    if( nullptr != pointSet ) {
+      bytes += pointSet->GetSize() * sizeof( ROOT::REveVector ) ;
+    }
+    auto renderData = element->GetRenderData() ;
+    if( nullptr != renderData ) {
+      bytes += renderData->GetBinarySize() ;
+    }
+    for( auto child : element->RefChildren() ) {
+      bytes += EstimateElementBytes( child ) ;
+    }
+    return bytes ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t MemoryMonitor::ParseSize( const std::string &size ) {
+    std::stringstream ss( size ) ;
+    double value(0.) ;
+    std::string unit ;
+    if( (ss >> value).fail() or value < 0. ) {
+      throw std::runtime_error( "Invalid memory size '" + size + "'" ) ;
+    }
+    ss >> unit ;
+    double factor = 1. ;
+    if( unit.empty() or unit == "B" ) {
+      factor = 1. ;
+    }
+    else if( unit == "K" or unit == "KB" ) {
+      factor = 1024. ;
+    }
+    else if( unit == "M" or unit == "MB" ) {
+      factor = 1024. * 1024. ;
+    }
+    else if( unit == "G" or unit == "GB" ) {
+      factor = 1024. * 1024. * 1024. ;
+    }
+    else {
+      throw std::runtime_error( "Invalid memory size unit '" + unit + "' (use K, M or G)" ) ;
+    }
+    return static_cast<std::size_t>( value * factor ) ;
+  }
+
+}
@@ -0,0 +1,127 @@
+// -- lceve headers
+#include <LCEve/Metrics.h>
+
+// -- std headers
+#include <sstream>
+#include <algorithm>
+
+namespace lceve {
+
+  Metrics::Timer::Timer( Metrics &metrics, const std::string &name ) :
+    fMetrics(metrics),
+    fName(name),
+    fStart(std::chrono::steady_clock::now()) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  Metrics::Timer::~Timer() {
+    fMetrics.Observe( fName, std::chrono::duration<double>( std::chrono::steady_clock::now() - fStart ).count() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  std::string Metrics::Name( const std::string &name, const std::string &label, const std::string &value ) {
+    return name + "{" + label + "=\"" + value + "\"}" ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Metrics::Increment( const std::string &name, double value ) {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    fCounters[ name ] += value ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Metrics::Set( const std::string &name, double value ) {
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    fGauges[ name ] = value ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Metrics::Observe( const std::string &name, double value ) {
+    auto bucket = std::distance( fgBucketBounds.begin(), std::lower_bound( fgBucketBounds.begin(), fgBucketBounds.end(), value ) ) ;
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    auto &histogram = fHistograms[ name ] ;
+    histogram.fBuckets[ bucket ]++ ;
+    histogram.fCount++ ;
+    histogram.fSum += value ;
+    histogram.fMax = (1 == histogram.fCount) ? value : std::max( histogram.fMax, value ) ;
+    histogram.fLast = value ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::string Metrics::ToText() const {
+    // split 'name{labels}' in name and labels for adding suffixes and the bucket label
+    auto split = []( const std::string &fullName ) {
+      auto pos = fullName.find( '{' ) ;
+      if( std::string::npos == pos ) {
+        return std::make_pair( fullName, std::string() ) ;
+      }
+      return std::make_pair( fullName.substr( 0, pos ), fullName.substr( pos+1, fullName.size()-pos-2 ) ) ;
+    } ;
+    auto withLabels = []( const std::string &labels, const std::string &extra ) {
+      if( labels.empty() and extra.empty() ) {
+        return std::string() ;
+      }
+      return "{" + labels + ((labels.empty() or extra.empty()) ? "" : ",") + extra + "}" ;
+    } ;
+    std::stringstream ss ;
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    for( auto &counter : fCounters ) {
+      ss << counter.first << " " << counter.second << "\n" ;
+    }
+    for( auto &gauge : fGauges ) {
+      ss << gauge.first << " " << gauge.second << "\n" ;
+    }
+    for( auto &histogram : fHistograms ) {
+      auto name = split( histogram.first ) ;
+      unsigned long cumulative = 0 ;
+      for( std::size_t b=0 ; b<histogram.second.fBuckets.size() ; ++b ) {
+        cumulative += histogram.second.fBuckets[b] ;
+        std::stringstream le ;
+        le << "le=\"" ;
+        if( b < fgBucketBounds.size() ) {
+          le << fgBucketBounds[b] ;
+        }
+        else {
+          le << "+Inf" ;
+        }
+        le << "\"" ;
+        ss << name.first << "_bucket" << withLabels( name.second, le.str() ) << " " << cumulative << "\n" ;
+      }
+      ss << name.first << "_sum" << withLabels( name.second, "" ) << " " << histogram.second.fSum << "\n" ;
+      ss << name.first << "_count" << withLabels( name.second, "" ) << " " << histogram.second.fCount << "\n" ;
+    }
+    return ss.str() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  nlohmann::json Metrics::Summary() const {
+    nlohmann::json summary = nlohmann::json::object() ;
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    for( auto &counter : fCounters ) {
+      summary[ counter.first ] = counter.second ;
+    }
+    for( auto &gauge : fGauges ) {
+      summary[ gauge.first ] = gauge.second ;
+    }
+    for( auto &histogram : fHistograms ) {
+      auto &h = histogram.second ;
+      summary[ histogram.first ] = {
+        {"last", h.fLast},
+        {"count", h.fCount},
+        {"mean", (h.fCount > 0) ? h.fSum / h.fCount : 0.},
+        {"max", h.fMax}
+      } ;
+    }
+    return summary ;
+  }
+
+}
@@ -0,0 +1,139 @@
+// -- lceve headers
+#include <LCEve/ObjectRegistry.h>
+
+namespace lceve {
+
+  ObjectRegistry::Scope::Scope( ObjectRegistry &registry, bool clear ) :
+    fRegistry(registry),
+    fPrevious(registry.fEnabled) {
+    if( clear ) {
+      fRegistry.Clear() ;
+    }
+    fRegistry.fEnabled = true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  ObjectRegistry::Scope::~Scope() {
+    fRegistry.fEnabled = fPrevious ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::Register( const void *object, ROOT::REveElement *element ) {
+    if( (not fEnabled) or (nullptr == object) or (nullptr == element) ) {
+      return ;
+    }
+    fElements.emplace( object, element ) ;
+    fIndex.emplace( object, Entry { element, -1 } ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::Index( const void *object, ROOT::REveElement *element, int index ) {
+    if( (not fEnabled) or (nullptr == object) or (nullptr == element) ) {
+      return ;
+    }
+    fIndex.emplace( object, Entry { element, index } ) ;
+    if( index >= 0 ) {
+      auto &points = fPoints[ element ] ;
+      if( points.size() <= static_cast<std::size_t>( index ) ) {
+        points.resize( index + 1, nullptr ) ;
+      }
+      points[ index ] = object ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::IndexRange( ROOT::REveElement *element, const void *const *objects, std::size_t n ) {
+    if( (not fEnabled) or (nullptr == element) or (0 == n) ) {
+      return ;
+    }
+    fRangeEntries.reserve( fRangeEntries.size() + n ) ;
+    for( std::size_t index=0 ; index<n ; ++index ) {
+      if( nullptr != objects[ index ] ) {
+        fRangeEntries.emplace_back( objects[ index ], Entry { element, static_cast<int>( index ) } ) ;
+      }
+    }
+    fRangesSorted = false ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::IndexCopy( const ROOT::REveElement *original, ROOT::REveElement *copy ) {
+    if( (not fEnabled) or (nullptr == copy) ) {
+      return ;
+    }
+    // points indexed by range. Rare (copies of large point sets): a scan is fine
+    const std::size_t nRangeEntries = fRangeEntries.size() ;
+    for( std::size_t e=0 ; e<nRangeEntries ; ++e ) {
+      // copy first, the insertion below may reallocate the array
+      const auto entry = fRangeEntries[ e ] ;
+      if( entry.second.fElement == original ) {
+        fRangeEntries.emplace_back( entry.first, Entry { copy, entry.second.fIndex } ) ;
+        fRangesSorted = false ;
+      }
+    }
+    auto iter = fPoints.find( original ) ;
+    if( fPoints.end() == iter ) {
+      return ;
+    }
+    // copy first, the insertion below may rehash the map
+    auto points = iter->second ;
+    for( std::size_t index=0 ; index<points.size() ; ++index ) {
+      if( nullptr != points[ index ] ) {
+        this->Index( points[ index ], copy, static_cast<int>( index ) ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::CountReused() {
+    ++fReused ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t ObjectRegistry::GetSize() const {
+    return fElements.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t ObjectRegistry::GetReused() const {
+    return fReused ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t ObjectRegistry::GetIndexSize() const {
+    return fIndex.size() + fRangeEntries.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::Clear() {
+    fElements.clear() ;
+    fIndex.clear() ;
+    fPoints.clear() ;
+    fRangeEntries.clear() ;
+    fRangesSorted = true ;
+    fReused = 0 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ObjectRegistry::SortRanges() const {
+    if( fRangesSorted ) {
+      return ;
+    }
+    std::sort( fRangeEntries.begin(), fRangeEntries.end(), []( const RangeEntry &lhs, const RangeEntry &rhs ) {
+      return std::less<const void*>()( lhs.first, rhs.first ) ;
+    }) ;
+    fRangesSorted = true ;
+  }
+
+}
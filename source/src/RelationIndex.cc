@@ -0,0 +1,116 @@
+// -- lceve headers
+#include <LCEve/RelationIndex.h>
+
+// -- lcio headers
+#include <EVENT/LCCollection.h>
+#include <EVENT/LCRelation.h>
+
+// -- std headers
+#include <algorithm>
+
+namespace lceve {
+
+  void RelationIndex::Build( const EVENT::LCCollection *const collection ) {
+    const int nRelations = collection->getNumberOfElements() ;
+    fBuffer.clear() ;
+    fBuffer.reserve( nRelations ) ;
+    for( int i=0 ; i<nRelations ; ++i ) {
+      auto relation = static_cast<const EVENT::LCRelation*>( collection->getElementAt( i ) ) ;
+      fBuffer.push_back( { relation->getFrom(), Link { relation->getTo(), relation->getWeight() } } ) ;
+    }
+    fFromTable.Build( fBuffer ) ;
+    // swap both sides for the reverse direction
+    for( auto &entry : fBuffer ) {
+      std::swap( entry.first, entry.second.fObject ) ;
+    }
+    fToTable.Build( fBuffer ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const RelationIndex::Link *RelationIndex::GetBestTo( const EVENT::LCObject *from ) const {
+    auto range = fFromTable.Find( from ) ;
+    return (range.first == range.second) ? nullptr : range.first ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const RelationIndex::Link *RelationIndex::GetBestFrom( const EVENT::LCObject *to ) const {
+    auto range = fToTable.Find( to ) ;
+    return (range.first == range.second) ? nullptr : range.first ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t RelationIndex::GetSize() const {
+    return fFromTable.fLinks.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RelationIndex::Clear() {
+    fFromTable.Clear() ;
+    fToTable.Clear() ;
+    fBuffer.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  void RelationIndex::Table::Build( const std::vector<std::pair<const EVENT::LCObject*, Link>> &links ) {
+    this->Clear() ;
+    fRows.reserve( links.size() ) ;
+    // count the links per row, rows in order of first appearance
+    std::vector<std::uint32_t> linkRows {} ;
+    linkRows.reserve( links.size() ) ;
+    for( auto &entry : links ) {
+      auto iter = fRows.emplace( entry.first, static_cast<std::uint32_t>( fObjects.size() ) ).first ;
+      if( iter->second == fObjects.size() ) {
+        fObjects.push_back( entry.first ) ;
+        fOffsets.push_back( 0 ) ;
+      }
+      ++fOffsets[ iter->second ] ;
+      linkRows.push_back( iter->second ) ;
+    }
+    // exclusive prefix sum: counts to row starts
+    std::uint32_t offset = 0 ;
+    for( auto &count : fOffsets ) {
+      std::swap( count, offset ) ;
+      offset += count ;
+    }
+    fOffsets.push_back( offset ) ;
+    // scatter the links into their rows
+    fLinks.resize( links.size() ) ;
+    std::vector<std::uint32_t> cursors( fOffsets.begin(), fOffsets.end() - 1 ) ;
+    for( std::size_t i=0 ; i<links.size() ; ++i ) {
+      fLinks[ cursors[ linkRows[i] ]++ ] = links[i].second ;
+    }
+    // best link first
+    for( std::size_t row=0 ; row+1<fOffsets.size() ; ++row ) {
+      std::stable_sort( fLinks.begin() + fOffsets[row], fLinks.begin() + fOffsets[row+1], []( const Link &lhs, const Link &rhs ){
+        return lhs.fWeight > rhs.fWeight ;
+      }) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::pair<const RelationIndex::Link*, const RelationIndex::Link*> RelationIndex::Table::Find( const EVENT::LCObject *object ) const {
+    auto iter = fRows.find( object ) ;
+    if( fRows.end() == iter ) {
+      return { nullptr, nullptr } ;
+    }
+    auto links = fLinks.data() ;
+    return { links + fOffsets[ iter->second ], links + fOffsets[ iter->second + 1 ] } ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RelationIndex::Table::Clear() {
+    fRows.clear() ;
+    fObjects.clear() ;
+    fOffsets.clear() ;
+    fLinks.clear() ;
+  }
+
+}
@@ -0,0 +1,89 @@
+// -- lceve headers
+#include <LCEve/SyntheticEvent.h>
+
+// -- lcio headers
+#include <EVENT/LCIO.h>
+#include <IMPL/LCEventImpl.h>
+#include <IMPL/LCCollectionVec.h>
+#include <IMPL/MCParticleImpl.h>
+#include <IMPL/CalorimeterHitImpl.h>
+#include <IMPL/TrackImpl.h>
+#include <IMPL/TrackStateImpl.h>
+#include <UTIL/LCRelationNavigator.h>
+
+// -- std headers
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace lceve {
+
+  std::unique_ptr<EVENT::LCEvent> SyntheticEvent::Create( int eventNumber, int size, std::mt19937 &generator ) {
+    std::uniform_real_distribution<float> unit( -1.f, 1.f ) ;
+    std::exponential_distribution<float> energy( 0.2f ) ;
+    auto event = std::make_unique<IMPL::LCEventImpl>() ;
+    event->setRunNumber( 0 ) ;
+    event->setEventNumber( eventNumber ) ;
+    event->setDetectorName( "synthetic" ) ;
+
+    auto particles = new IMPL::LCCollectionVec( EVENT::LCIO::MCPARTICLE ) ;
+    static const int pdgs[] = { 11, -11, 13, -13, 22, 211, -211, 2112 } ;
+    for( int i=0 ; i<size ; ++i ) {
+      auto particle = new IMPL::MCParticleImpl() ;
+      const int pdg = pdgs[ i % (sizeof(pdgs)/sizeof(int)) ] ;
+      const double e = 0.1 + energy( generator ) ;
+      const double momentum[3] = { e*unit( generator ), e*unit( generator ), e*unit( generator ) } ;
+      const double vertex[3] = { unit( generator ), unit( generator ), unit( generator ) } ;
+      particle->setPDG( pdg ) ;
+      particle->setGeneratorStatus( 1 ) ;
+      particle->setCharge( (pdg == 22 or pdg == 2112) ? 0.f : (pdg > 0 ? -1.f : 1.f) ) ;
+      particle->setMass( 0.1 ) ;
+      particle->setMomentum( momentum ) ;
+      particle->setVertex( vertex ) ;
+      particles->addElement( particle ) ;
+    }
+    event->addCollection( particles, fgMCParticleCollection ) ;
+
+    auto caloHits = new IMPL::LCCollectionVec( EVENT::LCIO::CALORIMETERHIT ) ;
+    for( int i=0 ; i<fgCaloHitsPerObject*size ; ++i ) {
+      auto caloHit = new IMPL::CalorimeterHitImpl() ;
+      const float phi = M_PI * unit( generator ) ;
+      const float radius = 1800.f + 200.f * std::fabs( unit( generator ) ) ;
+      const float position[3] = { radius*std::cos( phi ), radius*std::sin( phi ), 2000.f*unit( generator ) } ;
+      caloHit->setPosition( position ) ;
+      caloHit->setEnergy( 0.01f * energy( generator ) ) ;
+      caloHits->addElement( caloHit ) ;
+    }
+    event->addCollection( caloHits, fgCaloHitCollection ) ;
+
+    auto tracks = new IMPL::LCCollectionVec( EVENT::LCIO::TRACK ) ;
+    for( int i=0 ; i<size ; ++i ) {
+      auto track = new IMPL::TrackImpl() ;
+      const float omega = 1e-3f * unit( generator ) ;
+      const float phi = M_PI * unit( generator ) ;
+      const float tanLambda = 2.f * unit( generator ) ;
+      const float referencePoint[3] = { 0.f, 0.f, 0.f } ;
+      for( int location : { EVENT::TrackState::AtIP, EVENT::TrackState::AtFirstHit, EVENT::TrackState::AtLastHit, EVENT::TrackState::AtCalorimeter } ) {
+        auto trackState = new IMPL::TrackStateImpl( location, 0.f, phi, omega, 0.f, tanLambda, std::vector<float>(15, 0.f), referencePoint ) ;
+        track->addTrackState( trackState ) ;
+      }
+      tracks->addElement( track ) ;
+    }
+    event->addCollection( tracks, fgTrackCollection ) ;
+
+    UTIL::LCRelationNavigator truthLinks( EVENT::LCIO::TRACK, EVENT::LCIO::MCPARTICLE ) ;
+    std::uniform_int_distribution<int> particleIndex( 0, std::max( size-1, 0 ) ) ;
+    for( int i=0 ; i<size ; ++i ) {
+      auto track = tracks->getElementAt( i ) ;
+      const float weight = 0.5f + 0.5f * std::fabs( unit( generator ) ) ;
+      truthLinks.addRelation( track, particles->getElementAt( i ), weight ) ;
+      // a fraction of the tracks share hits with a second particle
+      if( 0 == i % 4 ) {
+        truthLinks.addRelation( track, particles->getElementAt( particleIndex( generator ) ), 1.f - weight ) ;
+      }
+    }
+    event->addCollection( truthLinks.createLCCollection(), fgTrackTruthCollection ) ;
+    return event ;
+  }
+
+}
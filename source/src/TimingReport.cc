@@ -0,0 +1,94 @@
+// -- lceve headers
+#include <LCEve/TimingReport.h>
+
+// -- std headers
+#include <algorithm>
+#include <iomanip>
+
+namespace lceve {
+
+  TimingReport::Scope::Scope( TimingReport &report, const std::string &name ) :
+    fReport(report),
+    fName(name),
+    fStart(Clock::now()) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  TimingReport::Scope::~Scope() {
+    fReport.AddPhase( fName, fStart, Clock::now() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  TimingReport::TimingReport() :
+    fOrigin(Clock::now()) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void TimingReport::AddPhase( const std::string &name, Clock::time_point start, Clock::time_point end ) {
+    Phase phase {} ;
+    phase.fName = name ;
+    phase.fStart = std::chrono::duration<double>( start - fOrigin ).count() ;
+    phase.fDuration = std::chrono::duration<double>( end - start ).count() ;
+    std::lock_guard<std::mutex> lock( fMutex ) ;
+    fPhases.push_back( phase ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::vector<TimingReport::Phase> TimingReport::GetPhases() const {
+    std::vector<Phase> phases {} ;
+    {
+      std::lock_guard<std::mutex> lock( fMutex ) ;
+      phases = fPhases ;
+    }
+    std::stable_sort( phases.begin(), phases.end(), []( const Phase &lhs, const Phase &rhs ){
+      return lhs.fStart < rhs.fStart ;
+    }) ;
+    return phases ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  double TimingReport::GetElapsed() const {
+    return std::chrono::duration<double>( Clock::now() - fOrigin ).count() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void TimingReport::Print( std::ostream &out ) const {
+    auto phases = GetPhases() ;
+    double end = 0. ;
+    for( auto &phase : phases ) {
+      end = std::max( end, phase.fStart + phase.fDuration ) ;
+    }
+    out << "---------------------------------------------------------------" << std::endl ;
+    out << std::setw(10) << "Start (s)" << std::setw(14) << "Duration (s)" << "   Phase" << std::endl ;
+    out << "---------------------------------------------------------------" << std::endl ;
+    for( auto &phase : phases ) {
+      out << std::fixed << std::setprecision(3)
+          << std::setw(10) << phase.fStart
+          << std::setw(14) << phase.fDuration
+          << "   " << phase.fName << std::endl ;
+    }
+    out << "---------------------------------------------------------------" << std::endl ;
+    out << "Total: " << std::fixed << std::setprecision(3) << end << " s" << std::endl ;
+    out << std::defaultfloat ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  nlohmann::json TimingReport::ToJson() const {
+    auto phases = nlohmann::json::array() ;
+    for( auto &phase : GetPhases() ) {
+      phases.push_back( { {"name", phase.fName}, {"start", phase.fStart}, {"duration", phase.fDuration} } ) ;
+    }
+    return phases ;
+  }
+
+}
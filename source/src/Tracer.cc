@@ -0,0 +1,121 @@
+// -- lceve headers
+#include <LCEve/Tracer.h>
+#include <LCEve/json.h>
+
+// -- std headers
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace lceve {
+
+  /// A recorded span
+  struct TraceEvent {
+    /// The static span name, if any
+    const char              *fName {nullptr} ;
+    /// The dynamic span name, if no static one
+    std::string              fDynamicName {} ;
+    /// The start time
+    Tracer::Clock::time_point fStart {} ;
+    /// The end time
+    Tracer::Clock::time_point fEnd {} ;
+  };
+
+  /// The span buffer of a single thread
+  struct TraceBuffer {
+    /// Protects the spans. Only contended while writing the trace
+    std::mutex               fMutex {} ;
+    /// The trace thread id
+    int                      fThreadId {0} ;
+    /// The recorded spans
+    std::vector<TraceEvent>  fEvents {} ;
+  };
+
+  /// The global tracer state
+  struct TraceState {
+    /// Protects the buffer list
+    std::mutex                                  fMutex {} ;
+    /// The output file name
+    std::string                                 fFileName {} ;
+    /// The trace time origin
+    Tracer::Clock::time_point                   fOrigin {} ;
+    /// The buffers of all threads, kept alive after the threads exit
+    std::vector<std::shared_ptr<TraceBuffer>>   fBuffers {} ;
+  };
+
+  //--------------------------------------------------------------------------
+
+  static TraceState &GetTraceState() {
+    static TraceState state ;
+    return state ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::atomic<bool> Tracer::fgEnabled {false} ;
+
+  //--------------------------------------------------------------------------
+
+  void Tracer::Enable( const std::string &fileName ) {
+    auto &state = GetTraceState() ;
+    {
+      std::lock_guard<std::mutex> lock( state.fMutex ) ;
+      state.fFileName = fileName ;
+      state.fOrigin = Clock::now() ;
+    }
+    fgEnabled.store( true ) ;
+    std::cout << "Tracing enabled, trace will be written to " << fileName << std::endl ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Tracer::Record( const char *name, const std::string &dynamicName, Clock::time_point start, Clock::time_point end ) {
+    auto &state = GetTraceState() ;
+    thread_local std::shared_ptr<TraceBuffer> buffer = [&state](){
+      auto newBuffer = std::make_shared<TraceBuffer>() ;
+      std::lock_guard<std::mutex> lock( state.fMutex ) ;
+      newBuffer->fThreadId = state.fBuffers.size() + 1 ;
+      state.fBuffers.push_back( newBuffer ) ;
+      return newBuffer ;
+    }() ;
+    std::lock_guard<std::mutex> lock( buffer->fMutex ) ;
+    buffer->fEvents.push_back( TraceEvent { name, dynamicName, start, end } ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Tracer::Write() {
+    if( not IsEnabled() ) {
+      return ;
+    }
+    auto &state = GetTraceState() ;
+    std::lock_guard<std::mutex> lock( state.fMutex ) ;
+    std::ofstream file( state.fFileName ) ;
+    if( not file ) {
+      std::cout << "WARNING: Couldn't write trace file " << state.fFileName << std::endl ;
+      return ;
+    }
+    auto events = nlohmann::json::array() ;
+    std::size_t nEvents = 0 ;
+    for( auto &buffer : state.fBuffers ) {
+      std::lock_guard<std::mutex> bufferLock( buffer->fMutex ) ;
+      for( auto &event : buffer->fEvents ) {
+        events.push_back( {
+          {"name", (nullptr != event.fName) ? std::string( event.fName ) : event.fDynamicName},
+          {"cat", "lceve"},
+          {"ph", "X"},
+          {"pid", 1},
+          {"tid", buffer->fThreadId},
+          {"ts", std::chrono::duration<double, std::micro>( event.fStart - state.fOrigin ).count()},
+          {"dur", std::chrono::duration<double, std::micro>( event.fEnd - event.fStart ).count()}
+        } ) ;
+        ++nEvents ;
+      }
+    }
+    nlohmann::json trace = { {"traceEvents", events}, {"displayTimeUnit", "ms"} } ;
+    file << trace.dump() ;
+    std::cout << "Written " << nEvents << " trace events to " << state.fFileName << std::endl ;
+  }
+
+}
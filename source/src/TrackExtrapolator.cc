@@ -0,0 +1,147 @@
+// -- lceve headers
+#include <LCEve/TrackExtrapolator.h>
+
+// -- std headers
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace lceve {
+
+  TrackExtrapolator::TrackExtrapolator( std::pmr::memory_resource *resource ) :
+    fX( resource ),
+    fY( resource ),
+    fZ( resource ),
+    fPx( resource ),
+    fPy( resource ),
+    fPz( resource ),
+    fCharge( resource ),
+    fOutX( resource ),
+    fOutY( resource ),
+    fOutZ( resource ),
+    fValid( resource ) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void TrackExtrapolator::Reserve( std::size_t n ) {
+    for( auto vec : { &fX, &fY, &fZ, &fPx, &fPy, &fPz, &fCharge } ) {
+      vec->reserve( n ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void TrackExtrapolator::AddTrack( const ROOT::REveVectorT<float> &position, const ROOT::REveVectorT<float> &momentum, int charge ) {
+    fX.push_back( position.fX ) ;
+    fY.push_back( position.fY ) ;
+    fZ.push_back( position.fZ ) ;
+    fPx.push_back( momentum.fX ) ;
+    fPy.push_back( momentum.fY ) ;
+    fPz.push_back( momentum.fZ ) ;
+    fCharge.push_back( charge ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void TrackExtrapolator::Clear() {
+    for( auto vec : { &fX, &fY, &fZ, &fPx, &fPy, &fPz, &fCharge, &fOutX, &fOutY, &fOutZ } ) {
+      vec->clear() ;
+    }
+    fValid.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t TrackExtrapolator::GetSize() const {
+    return fX.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t TrackExtrapolator::Extrapolate( double faceR, double faceZ, double bz, double maxOrbs ) {
+    const std::size_t n = fX.size() ;
+    fOutX.resize( n ) ;
+    fOutY.resize( n ) ;
+    fOutZ.resize( n ) ;
+    fValid.resize( n ) ;
+    const double twoPi = 2. * M_PI ;
+    const double maxAlpha = twoPi * maxOrbs ;
+    const double infinity = std::numeric_limits<double>::infinity() ;
+    const double faceR2 = faceR * faceR ;
+    const double absBz = std::fabs( bz ) ;
+    // wrap an angle in [0, 2pi)
+    auto wrap = [twoPi]( double angle ) {
+      return angle - twoPi * std::floor( angle / twoPi ) ;
+    } ;
+    std::size_t nValid = 0 ;
+    for( std::size_t i=0 ; i<n ; ++i ) {
+      const double x0 = fX[i], y0 = fY[i], z0 = fZ[i] ;
+      const double px = fPx[i], py = fPy[i], pz = fPz[i] ;
+      const double charge = fCharge[i] ;
+      const double pt = std::sqrt( px*px + py*py ) ;
+      const double p = std::sqrt( pt*pt + pz*pz ) ;
+      const bool inside = ( x0*x0 + y0*y0 < faceR2 ) and ( std::fabs( z0 ) < faceZ ) ;
+      const double radius = ( 0. != charge and absBz > 0. and pt > 0. ) ? pt / ( fgMomentumFactor * absBz ) : infinity ;
+      double outX = 0., outY = 0., outZ = 0. ;
+      bool valid = false ;
+      if( std::isinf( radius ) ) {
+        // straight line: first crossing of the barrel or the endcap plane
+        const double ux = px/p, uy = py/p, uz = pz/p ;
+        const double ut2 = ux*ux + uy*uy ;
+        const double b = x0*ux + y0*uy ;
+        const double c = x0*x0 + y0*y0 - faceR2 ;
+        const double sBarrel = ( ut2 > 0. ) ? ( -b + std::sqrt( std::max( 0., b*b - ut2*c ) ) ) / ut2 : infinity ;
+        const double sEndcap = ( 0. != uz ) ? ( std::copysign( faceZ, uz ) - z0 ) / uz : infinity ;
+        const double s = std::min( sBarrel, sEndcap ) ;
+        valid = inside and ( p > 0. ) and std::isfinite( s ) ;
+        outX = x0 + s*ux ; outY = y0 + s*uy ; outZ = z0 + s*uz ;
+      }
+      else {
+        // clockwise rotation (seen from +z) for positive charges in a positive field
+        const double sense = ( charge * bz > 0. ) ? -1. : 1. ;
+        const double cx = x0 - sense * radius * py / pt ;
+        const double cy = y0 + sense * radius * px / pt ;
+        const double phiStart = std::atan2( y0 - cy, x0 - cx ) ;
+        const double dzdAlpha = radius * pz / pt ;
+        // barrel: |c + R u(phi)|^2 = faceR^2  <=>  cos(phi - phiC) = cosPsi
+        const double d2 = cx*cx + cy*cy ;
+        const double d = std::sqrt( d2 ) ;
+        const double cosPsi = ( faceR2 - d2 - radius*radius ) / std::max( 2. * d * radius, 1e-20 ) ;
+        double alphaBarrel = infinity ;
+        if( std::fabs( cosPsi ) <= 1. ) {
+          const double phiC = std::atan2( cy, cx ) ;
+          const double psi = std::acos( cosPsi ) ;
+          alphaBarrel = std::min( wrap( sense * ( phiC + psi - phiStart ) ), wrap( sense * ( phiC - psi - phiStart ) ) ) ;
+        }
+        const double alphaEndcap = ( 0. != pz ) ? ( std::copysign( faceZ, pz ) - z0 ) / dzdAlpha : infinity ;
+        const double alpha = std::min( alphaBarrel, alphaEndcap ) ;
+        valid = inside and ( alpha <= maxAlpha ) ;
+        const double phi = phiStart + sense * std::min( alpha, maxAlpha ) ;
+        outX = cx + radius * std::cos( phi ) ;
+        outY = cy + radius * std::sin( phi ) ;
+        outZ = z0 + dzdAlpha * std::min( alpha, maxAlpha ) ;
+      }
+      fOutX[i] = outX ;
+      fOutY[i] = outY ;
+      fOutZ[i] = outZ ;
+      fValid[i] = valid ? 1 : 0 ;
+      nValid += fValid[i] ;
+    }
+    return nValid ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool TrackExtrapolator::HasIntersection( std::size_t i ) const {
+    return ( 0 != fValid.at( i ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  ROOT::REveVectorT<float> TrackExtrapolator::GetIntersection( std::size_t i ) const {
+    return ROOT::REveVectorT<float>( fOutX.at( i ), fOutY.at( i ), fOutZ.at( i ) ) ;
+  }
+
+}
@@ -46,7 +46,7 @@ namespace lceve {
     for( auto p = element->FirstChildElement( "parameter" ) ; nullptr != p ; p = p->NextSiblingElement( "parameter" ) ) {
       // read parameter name
       const char* key = p->Attribute( "name" );
-      if( nullptr == key ) {
+      if( nullptr == key or name != key ) {
         continue ;
       }
       if( p->FirstChild() ) {
@@ -1,7 +1,105 @@
-sap.ui.define(['rootui5/eve7/controller/Main.controller', 'rootui5/eve7/lib/EveManager'],
-function(MainController, EveManager) {
+sap.ui.define(['rootui5/eve7/controller/Main.controller', 'rootui5/eve7/lib/EveManager', 'rootui5/eve7/lib/EveElements'],
+function(MainController, EveManager, EveElements) {
   "use strict";
 
+  /// Render function of lceve::InstancedGeoShape elements.
+  /// The render data holds the shape mesh followed by the placement matrices (16 floats each)
+  EveElements.prototype.makeInstancedGeoShape = function(egs, rnr_data) {
+    var nInstances = egs.fNInstances;
+    var nMeshFloats = rnr_data.vtxBuff.length - 16 * nInstances;
+    var body = new THREE.BufferGeometry();
+    var position = new THREE.BufferAttribute(rnr_data.vtxBuff.subarray(0, nMeshFloats), 3);
+    if (body.setAttribute) {
+      body.setAttribute('position', position);
+    }
+    else {
+      body.addAttribute('position', position);
+    }
+    body.setIndex(new THREE.BufferAttribute(rnr_data.idxBuff, 1));
+    // skip the primitive type and count
+    body.setDrawRange(2, rnr_data.idxBuff.length - 2);
+    body.computeVertexNormals();
+    var material = new THREE.MeshPhongMaterial({
+      depthWrite: false,
+      color: this.ColorFromIdx(egs.fMainColor),
+      transparent: true,
+      opacity: (100 - egs.fMainTransparency) / 100.0
+    });
+    var placements = rnr_data.vtxBuff.subarray(nMeshFloats);
+    var group = new THREE.Object3D();
+    if (THREE.InstancedMesh) {
+      // one draw call for all placements
+      var mesh = new THREE.InstancedMesh(body, material, nInstances);
+      var matrix = new THREE.Matrix4();
+      for (var i = 0; i < nInstances; ++i) {
+        matrix.fromArray(placements, 16 * i);
+        mesh.setMatrixAt(i, matrix);
+      }
+      mesh.instanceMatrix.needsUpdate = true;
+      group.add(mesh);
+    }
+    else {
+      // older three.js: the geometry is still shared between the meshes
+      for (var j = 0; j < nInstances; ++j) {
+        var instance = new THREE.Mesh(body, material);
+        instance.matrixAutoUpdate = false;
+        instance.matrix.fromArray(placements, 16 * j);
+        group.add(instance);
+      }
+    }
+    return group;
+  };
+
+  /// Decoder of the lceve::CompactEncoding render data (see CompactEncoding.h).
+  /// Returns a copy of the render data with the decoded positions in the vertex buffer
+  var LCEveCompact = {
+    magic: 0x3145434c,
+    headerWords: 7,
+
+    decode: function(rnr_data) {
+      var vtx = rnr_data.vtxBuff;
+      var header = new Uint32Array(vtx.buffer, vtx.byteOffset, this.headerWords);
+      if (header[0] != this.magic) {
+        console.error("LCEve: invalid compact render data");
+        return rnr_data;
+      }
+      var nPoints = header[1];
+      var resolution = vtx[2];
+      var origin = [vtx[3], vtx[4], vtx[5]];
+      var payload = new Uint8Array(vtx.buffer, vtx.byteOffset + 4 * this.headerWords, header[6]);
+      var points = new Float32Array(3 * nPoints);
+      var current = [0, 0, 0];
+      var pos = 0;
+      for (var i = 0; i < 3 * nPoints; ++i) {
+        // varint, without 32 bits shifts: the values may exceed 2^31
+        var value = 0, scale = 1, b;
+        do {
+          b = payload[pos++];
+          value += (b & 0x7f) * scale;
+          scale *= 128;
+        } while (b & 0x80);
+        // zigzag
+        var delta = (value % 2) ? -(value + 1) / 2 : value / 2;
+        var axis = i % 3;
+        current[axis] += delta;
+        points[i] = origin[axis] + resolution * current[axis];
+      }
+      var decoded = Object.assign({}, rnr_data);
+      decoded.vtxBuff = points;
+      return decoded;
+    }
+  };
+
+  /// Render function of the lceve::CompactPointSet elements (hits)
+  EveElements.prototype.makeCompactHit = function(hit, rnr_data) {
+    return this.makeHit(hit, LCEveCompact.decode(rnr_data));
+  };
+
+  /// Render function of the lceve::CompactTrack elements (tracks, particles)
+  EveElements.prototype.makeCompactTrack = function(track, rnr_data) {
+    return this.makeTrack(track, LCEveCompact.decode(rnr_data));
+  };
+
   return MainController.extend("custom.MyNewMain", {
 
     /// On websocket opened
@@ -100,6 +198,24 @@ function(MainController, EveManager) {
       alert("=====User support: dummy@cern.ch");
     },
 
+    /// Show the startup timing report of the application
+    showStartupReport : function(oEvent) {
+      var phases = this.eventDisplay.startup || [];
+      var text = phases.map(function(phase) {
+        return phase.start.toFixed(3) + " s  +" + phase.duration.toFixed(3) + " s  " + phase.name;
+      }).join("\n");
+      var dialog = new sap.m.Dialog({
+        title: "Startup timing report",
+        content: new sap.m.Text({ text: text, renderWhitespace: true }).addStyleClass("sapUiSmallMargin"),
+        endButton: new sap.m.Button({
+          text: "Close",
+          press: function() { dialog.close(); }
+        }),
+        afterClose: function() { dialog.destroy(); }
+      });
+      dialog.open();
+    },
+
     /// Load the current event info on the corresponding widgets
     showEventInfo : function() {
       document.title = "LCEve: Run " + this.eventMgr.run + " / Event " + this.eventMgr.event ;
@@ -107,6 +223,128 @@ function(MainController, EveManager) {
       this.byId("event-input").setValue(this.eventMgr.event);
       this.byId("date-label").setText(this.eventMgr.date);
       this.byId("detector-input").setValue(this.eventMgr.detector);
+      this.showMetrics();
+    },
+
+    /// Show the pipeline timings of the last event in the footer
+    showMetrics : function() {
+      var metrics = this.eventMgr.metrics;
+      if (!metrics) {
+        return;
+      }
+      function lastMs(name) {
+        return metrics[name] ? (1000 * metrics[name].last).toFixed(1) + " ms" : "-";
+      }
+      this.byId("FooterLbl1").setText("Event: " + lastMs("lceve_event_seconds"));
+      this.byId("FooterLbl2").setText("LCIO read: " + lastMs("lceve_lcio_read_seconds"));
+      this.byId("FooterLbl3").setText("Redraw: " + lastMs("lceve_redraw_seconds"));
+      var bytes = metrics["lceve_render_data_bytes"];
+      this.byId("FooterLbl4").setText("Render data: " + (bytes ? (bytes.last / 1024).toFixed(0) + " kB" : "-"));
+    },
+
+    /// Get the id of the element currently selected in the viewers
+    getSelectedElementId : function() {
+      var selection = this.mgr.GetElement(this.mgr.global_selection_id);
+      if (!selection || !selection.sel_list || selection.sel_list.length == 0) {
+        return -1;
+      }
+      return selection.sel_list[0].primary;
+    },
+
+    /// Expand the selected geometry element by one level
+    expandGeometry : function(oEvent) {
+      var elementId = this.getSelectedElementId();
+      if (elementId < 0) {
+        return;
+      }
+      this.mgr.SendMIR({
+        "mir":        "ExpandGeometry(" + elementId + ", 1)",
+        "fElementId": this.eventDisplay.fElementId,
+        "class":      "lceve::EventDisplay"
+      });
+    },
+
+    /// Build the constituents of the selected jet
+    expandJet : function(oEvent) {
+      var elementId = this.getSelectedElementId();
+      if (elementId < 0) {
+        return;
+      }
+      this.mgr.SendMIR({
+        "mir":        "ExpandJet(" + elementId + ")",
+        "fElementId": this.eventDisplay.fElementId,
+        "class":      "lceve::EventDisplay"
+      });
+    },
+
+    /// Highlight the elements related to the selected one in all collections
+    highlightRelated : function(oEvent) {
+      var elementId = this.getSelectedElementId();
+      if (elementId < 0) {
+        return;
+      }
+      this.mgr.SendMIR({
+        "mir":        "HighlightRelated(" + elementId + ")",
+        "fElementId": this.eventDisplay.fElementId,
+        "class":      "lceve::EventDisplay"
+      });
+    },
+
+    /// Highlight the truth (relations) of the selected element
+    showTruth : function(oEvent) {
+      var elementId = this.getSelectedElementId();
+      if (elementId < 0) {
+        return;
+      }
+      this.mgr.SendMIR({
+        "mir":        "ShowTruth(" + elementId + ")",
+        "fElementId": this.eventDisplay.fElementId,
+        "class":      "lceve::EventDisplay"
+      });
+    },
+
+    /// Collapse the selected geometry element (daughters are unloaded)
+    collapseGeometry : function(oEvent) {
+      var elementId = this.getSelectedElementId();
+      if (elementId < 0) {
+        return;
+      }
+      this.mgr.SendMIR({
+        "mir":        "CollapseGeometry(" + elementId + ")",
+        "fElementId": this.eventDisplay.fElementId,
+        "class":      "lceve::EventDisplay"
+      });
+    },
+
+    /// Show a dialog with a depth level slider per subdetector
+    showGeometryLevels : function(oEvent) {
+      var self = this;
+      var content = [];
+      var subdetectors = this.eventDisplay.subdetectors || [];
+      subdetectors.forEach(function(subdet) {
+        content.push(new sap.m.Label({ text: subdet.name }));
+        content.push(new sap.m.Slider({
+          min: 0, max: 10, step: 1, value: subdet.level,
+          enableTickmarks: true, inputsAsTooltips: true, width: "300px",
+          change: function(oSliderEvent) {
+            self.mgr.SendMIR({
+              "mir":        "SetSubdetectorLevel(\"" + subdet.name + "\", " + oSliderEvent.getParameter("value") + ")",
+              "fElementId": self.eventDisplay.fElementId,
+              "class":      "lceve::EventDisplay"
+            });
+          }
+        }));
+      });
+      var dialog = new sap.m.Dialog({
+        title: "Subdetector depth levels",
+        content: new sap.m.VBox({ items: content }).addStyleClass("sapUiSmallMargin"),
+        endButton: new sap.m.Button({
+          text: "Close",
+          press: function() { dialog.close(); }
+        }),
+        afterClose: function() { dialog.destroy(); }
+      });
+      dialog.open();
     },
 
     /// Go to the next event